@@ -0,0 +1,106 @@
+#ifndef SRC_BENCHMARKS_BENCHMARK_H
+#define SRC_BENCHMARKS_BENCHMARK_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include "../lib/local_search.h"
+#include "../lib/s21_graph_algorithms.h"
+#include "../lib/tour_construction.h"
+
+/**
+ * @brief Wall-clock stopwatch started on construction
+ *
+ */
+class Timer {
+ public:
+  Timer() : start_(std::chrono::steady_clock::now()) {}
+
+  double Seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_)
+        .count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Returns graph of the adjacency matrix. The graph goes through a file
+ * because Graph is loaded only this way.
+ *
+ */
+inline Graph MakeGraph(const Graph::Matrix &m) {
+  const std::string filename = "./benchmark_graph.txt";
+  {
+    std::ofstream file(filename);
+    file << m.size();
+    for (const auto &row : m) {
+      file << '\n';
+      for (size_t j = 0; j < row.size(); ++j) file << (j ? " " : "") << row[j];
+    }
+  }
+  Graph graph;
+  graph.LoadGraphFromFile(filename);
+  std::remove(filename.c_str());
+  return graph;
+}
+
+/**
+ * @brief Returns random graph with given share of edges and weights in
+ * [1, max_weight]
+ *
+ */
+inline Graph MakeRandomGraph(size_t size, double density, int max_weight,
+                             bool directed, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> edge(0.0, 1.0);
+  std::uniform_int_distribution<int> weight(1, max_weight);
+  Graph::Matrix m(size, std::vector<int>(size));
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = directed ? 0 : i + 1; j < size; ++j) {
+      if (i != j && edge(gen) < density) {
+        m[i][j] = weight(gen);
+        if (!directed) m[j][i] = m[i][j];
+      }
+    }
+  }
+  return MakeGraph(m);
+}
+
+/**
+ * @brief Returns complete graph of random points of a square of the given
+ * side with the rounded Euclidean distances, which keep the triangle
+ * inequality up to rounding
+ *
+ */
+inline Graph MakeEuclideanGraph(size_t size, double side, unsigned seed,
+                                std::vector<TourConstruction::Point> *points) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> coordinate(0.0, side);
+  points->resize(size);
+  for (auto &point : *points) point = {coordinate(gen), coordinate(gen)};
+  Graph::Matrix m(size, std::vector<int>(size));
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      double dx = (*points)[i].x - (*points)[j].x;
+      double dy = (*points)[i].y - (*points)[j].y;
+      if (i != j) m[i][j] = std::max(1L, std::lround(std::hypot(dx, dy)));
+    }
+  }
+  return MakeGraph(m);
+}
+
+inline void PrintHeader(const std::string &title) {
+  std::cout << "\n== " << title << " ==\n";
+}
+
+#endif  // SRC_BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,31 @@
+#include "shortest_paths_benchmarks.cc"
+#include "spanning_tree_benchmarks.cc"
+#include "tsm_benchmarks.cc"
+
+int main() {
+  std::cout << "Hardware threads: " << ThreadPool::DefaultThreadsCount()
+            << '\n';
+  BenchShortestPathsBetweenPairs();
+  BenchDeltaStepping();
+  BenchSpanningTree();
+  BenchSpanningTreeMemory();
+  BenchRandom();
+  BenchAntAlgorithm();
+  BenchAntAlgorithmThreads();
+  BenchAntAlgorithmNeighbours();
+  BenchAntAlgorithmModes();
+  BenchAntAlgorithmIslands();
+  BenchAnnealing();
+  BenchAnnealingModes();
+  BenchAnnealingBudget();
+  BenchGenetic();
+  BenchGeneticCrossovers();
+  BenchGeneticIslands();
+  BenchLocalSearch();
+  BenchLinKernighan();
+  BenchExactTsm();
+  BenchTourConstruction();
+  BenchWarmStart();
+  BenchPortfolio();
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include "benchmark.h"
+
+/**
+ * @brief Throughput of the batched pairs query against a loop of point
+ * queries, pairs are spread over a limited number of distinct sources as the
+ * dispatcher sends them
+ *
+ */
+void BenchShortestPathsBetweenPairs() {
+  PrintHeader("Shortest paths between pairs, pairs per second");
+  std::cout << std::setw(8) << "size" << std::setw(8) << "pairs"
+            << std::setw(14) << "loop" << std::setw(14) << "batch x1"
+            << std::setw(14) << "batch xN" << '\n';
+  for (size_t size : {500, 2000}) {
+    Graph graph = MakeRandomGraph(size, 0.05, 100, false, size);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> vertex(1, size);
+    std::vector<int> sources(32);
+    for (int &source : sources) source = vertex(gen);
+    GraphAlgorithms::Pairs pairs(4000);
+    for (auto &pair : pairs) {
+      pair = {sources[gen() % sources.size()], vertex(gen)};
+    }
+
+    const size_t kLoopPairs = 400;
+    Timer loop_timer;
+    for (size_t i = 0; i < kLoopPairs; ++i) {
+      GraphAlgorithms::GetShortestPathBetweenVertices(graph, pairs[i].first,
+                                                      pairs[i].second);
+    }
+    double loop = loop_timer.Seconds() * pairs.size() / kLoopPairs;
+    Timer single_timer;
+    GraphAlgorithms::GetShortestPathsBetweenPairs(graph, pairs, 1);
+    double single = single_timer.Seconds();
+    Timer multi_timer;
+    GraphAlgorithms::GetShortestPathsBetweenPairs(graph, pairs);
+    double multi = multi_timer.Seconds();
+
+    std::cout << std::setw(8) << size << std::setw(8) << pairs.size()
+              << std::setw(14) << static_cast<int>(pairs.size() / loop)
+              << std::setw(14) << static_cast<int>(pairs.size() / single)
+              << std::setw(14) << static_cast<int>(pairs.size() / multi)
+              << '\n';
+  }
+}
+
+/**
+ * @brief Scaling of delta-stepping with the number of threads against
+ * sequential Dijkstra from the same source
+ *
+ */
+void BenchDeltaStepping() {
+  PrintHeader("Delta-stepping single source, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(8) << "delta"
+            << std::setw(12) << "dijkstra";
+  for (size_t threads : {1, 2, 4, 8}) {
+    std::cout << std::setw(10) << "x" + std::to_string(threads);
+  }
+  std::cout << '\n';
+  for (size_t size : {2000, 5000}) {
+    Graph graph = MakeRandomGraph(size, 0.02, 1000, true, size);
+    Timer dijkstra_timer;
+    GraphAlgorithms::Vector expected =
+        GraphAlgorithms::GetShortestPathsFromVertex(graph, 1);
+    double dijkstra = dijkstra_timer.Seconds();
+    std::cout << std::setw(8) << size << std::setw(8)
+              << DeltaStepping::ChooseDelta(graph) << std::setw(12)
+              << dijkstra;
+    for (size_t threads : {1, 2, 4, 8}) {
+      Timer timer;
+      GraphAlgorithms::Vector result =
+          GraphAlgorithms::GetShortestPathsDeltaStepping(graph, 1, threads);
+      double seconds = timer.Seconds();
+      std::cout << std::setw(10) << (result == expected ? seconds : -1.0);
+    }
+    std::cout << '\n';
+  }
+}
@@ -0,0 +1,58 @@
+#include "benchmark.h"
+
+/**
+ * @brief Array and heap variants of Prim's algorithm, Kruskal's and Borůvka's
+ * algorithms on dense and sparse graphs
+ *
+ */
+void BenchSpanningTree() {
+  PrintHeader("Minimal spanning tree, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(10) << "density"
+            << std::setw(12) << "dense" << std::setw(12) << "sparse"
+            << std::setw(12) << "kruskal" << std::setw(12) << "boruvka"
+            << '\n';
+  for (size_t size : {1000, 3000}) {
+    for (double density : {0.02, 0.5}) {
+      Graph graph = MakeRandomGraph(size, density, 1000, false, size);
+      Timer dense_timer;
+      GraphAlgorithms::GetLeastSpanningTreeDense(graph);
+      double dense = dense_timer.Seconds();
+      Timer sparse_timer;
+      GraphAlgorithms::GetLeastSpanningTreeSparse(graph);
+      double sparse = sparse_timer.Seconds();
+      Timer kruskal_timer;
+      GraphAlgorithms::GetLeastSpanningTreeKruskal(graph);
+      double kruskal = kruskal_timer.Seconds();
+      Timer boruvka_timer;
+      GraphAlgorithms::GetLeastSpanningTreeBoruvka(graph);
+      double boruvka = boruvka_timer.Seconds();
+      std::cout << std::setw(8) << size << std::setw(10) << density
+                << std::setw(12) << dense << std::setw(12) << sparse
+                << std::setw(12) << kruskal << std::setw(12) << boruvka
+                << '\n';
+    }
+  }
+}
+
+/**
+ * @brief Memory taken by the minimal spanning tree as an adjacency matrix and
+ * as a list of edges
+ *
+ */
+void BenchSpanningTreeMemory() {
+  PrintHeader("Minimal spanning tree result, bytes");
+  std::cout << std::setw(8) << "size" << std::setw(16) << "matrix"
+            << std::setw(16) << "edges" << '\n';
+  for (size_t size : {1000, 3000}) {
+    Graph graph = MakeRandomGraph(size, 0.02, 1000, false, size);
+    MstResult tree = GraphAlgorithms::GetLeastSpanningTreeEdges(graph);
+    GraphAlgorithms::Matrix matrix = tree.ToMatrix();
+    size_t matrix_bytes =
+        sizeof(matrix) + matrix.capacity() * sizeof(matrix[0]);
+    for (const auto &row : matrix) matrix_bytes += row.capacity() * sizeof(int);
+    size_t edges_bytes =
+        sizeof(tree) + tree.edges.capacity() * sizeof(tree.edges[0]);
+    std::cout << std::setw(8) << size << std::setw(16) << matrix_bytes
+              << std::setw(16) << edges_bytes << '\n';
+  }
+}
@@ -0,0 +1,669 @@
+#include "benchmark.h"
+
+/**
+ * @brief Cost of a random number: a new std::random_device on every call as
+ * the solvers did before, against the xoshiro256++ generator
+ *
+ */
+void BenchRandom() {
+  PrintHeader("Random numbers, nanoseconds per number");
+  const int kDraws = 1000000;
+  int sink = 0;
+  Timer device_timer;
+  for (int i = 0; i < kDraws / 100; ++i) {
+    std::uniform_int_distribution<int> dist(0, 100);
+    std::random_device rd;
+    sink += dist(rd);
+  }
+  double device = device_timer.Seconds() * 1e9 / (kDraws / 100);
+  Random random(1);
+  Timer random_timer;
+  for (int i = 0; i < kDraws; ++i) sink += random.NextInt(0, 100);
+  double xoshiro = random_timer.Seconds() * 1e9 / kDraws;
+  std::cout << "random_device: " << device << "\nxoshiro256++:  " << xoshiro
+            << "\n(checksum " << sink % 10 << ")\n";
+}
+
+/**
+ * @brief Run time of the ant colony solver
+ *
+ */
+void BenchAntAlgorithm() {
+  PrintHeader("Ant colony, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  for (size_t size : {25, 50, 100}) {
+    Graph graph = MakeRandomGraph(size, 1.0, 1000, false, size);
+    Timer timer;
+    AntAlgorithm algo(graph, 1);
+    algo.RunAlgorithm();
+    TsmResult result = algo.GetResult();
+    std::cout << std::setw(8) << size << std::setw(12) << timer.Seconds()
+              << std::setw(12) << result.distance << '\n';
+  }
+}
+
+/**
+ * @brief Run time of the ant colony by number of threads
+ *
+ */
+void BenchAntAlgorithmThreads() {
+  PrintHeader("Ant colony on 50 vertices by threads, seconds");
+  std::cout << std::setw(8) << "threads" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  Graph graph = MakeRandomGraph(50, 1.0, 1000, false, 50);
+  for (size_t threads : {1, 2, 4}) {
+    Timer timer;
+    AntAlgorithm algo(graph, 1);
+    algo.SetThreadsCount(threads);
+    algo.RunAlgorithm();
+    TsmResult result = algo.GetResult();
+    std::cout << std::setw(8) << threads << std::setw(12) << timer.Seconds()
+              << std::setw(12) << result.distance << '\n';
+  }
+}
+
+/**
+ * @brief Run time of the ant colony by length of the candidate lists
+ *
+ */
+void BenchAntAlgorithmNeighbours() {
+  PrintHeader("Ant colony on 100 vertices by neighbours, seconds");
+  std::cout << std::setw(8) << "k" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  Graph graph = MakeRandomGraph(100, 1.0, 1000, false, 100);
+  for (size_t count : {5, 15, 99}) {
+    Timer timer;
+    AntAlgorithm algo(graph, 1);
+    algo.SetNeighboursCount(count);
+    algo.RunAlgorithm();
+    TsmResult result = algo.GetResult();
+    std::cout << std::setw(8) << count << std::setw(12) << timer.Seconds()
+              << std::setw(12) << result.distance << '\n';
+  }
+}
+
+/**
+ * @brief Time to target quality of the ant colony variants: every variant
+ * runs with doubling numbers of iterations until its tour is within 5% of the
+ * best tour of the full runs
+ *
+ */
+void BenchAntAlgorithmModes() {
+  PrintHeader("Ant colony variants on 100 vertices, seconds");
+  struct Variant {
+    const char *name;
+    AntAlgorithm::Mode mode;
+    bool polish;
+  };
+  const Variant variants[] = {
+      {"AS", AntAlgorithm::Mode::kAntSystem, false},
+      {"MMAS", AntAlgorithm::Mode::kMaxMin, false},
+      {"ACS", AntAlgorithm::Mode::kColonySystem, false},
+      {"AS+2opt", AntAlgorithm::Mode::kAntSystem, true},
+      {"MMAS+2opt", AntAlgorithm::Mode::kMaxMin, true},
+      {"ACS+2opt", AntAlgorithm::Mode::kColonySystem, true}};
+  Graph graph = MakeRandomGraph(100, 1.0, 1000, false, 100);
+  auto run = [&graph](const Variant &variant, size_t iterations) {
+    AntAlgorithm algo(graph, 1);
+    algo.SetMode(variant.mode);
+    algo.SetLocalSearch(variant.polish);
+    algo.SetIterationsCount(iterations);
+    algo.RunAlgorithm();
+    return algo.GetResult().distance;
+  };
+  const size_t kIterations = 1000;
+  std::vector<double> times, distances;
+  for (const Variant &variant : variants) {
+    Timer timer;
+    distances.push_back(run(variant, kIterations));
+    times.push_back(timer.Seconds());
+  }
+  double target = *std::min_element(distances.begin(), distances.end()) * 1.05;
+  std::cout << "target " << target << '\n'
+            << std::setw(10) << "variant" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << std::setw(12) << "to target"
+            << '\n';
+  for (size_t i = 0; i < distances.size(); ++i) {
+    double reached = -1.0;
+    for (size_t iterations = 10;; iterations *= 2) {
+      iterations = std::min(iterations, kIterations);
+      Timer timer;
+      if (run(variants[i], iterations) <= target) {
+        reached = timer.Seconds();
+        break;
+      }
+      if (iterations == kIterations) break;
+    }
+    std::cout << std::setw(10) << variants[i].name << std::setw(12) << times[i]
+              << std::setw(12) << distances[i] << std::setw(12);
+    if (reached < 0.0) {
+      std::cout << "-" << '\n';
+    } else {
+      std::cout << reached << '\n';
+    }
+  }
+}
+
+/**
+ * @brief Run time of the ant colony by number of islands, one thread per
+ * island, with and without migration
+ *
+ */
+void BenchAntAlgorithmIslands() {
+  PrintHeader("MAX-MIN ant colony on 100 vertices by islands, seconds");
+  std::cout << std::setw(8) << "islands" << std::setw(12) << "migration"
+            << std::setw(12) << "time" << std::setw(12) << "distance"
+            << '\n';
+  Graph graph = MakeRandomGraph(100, 1.0, 1000, false, 100);
+  for (size_t islands : {1, 2, 4}) {
+    for (size_t migration : {0, 50}) {
+      Timer timer;
+      AntAlgorithm algo(graph, 1);
+      algo.SetMode(AntAlgorithm::Mode::kMaxMin);
+      algo.SetLocalSearch(true);
+      algo.SetIslandsCount(islands);
+      algo.SetThreadsCount(islands);
+      algo.SetMigrationInterval(migration);
+      algo.RunAlgorithm();
+      TsmResult result = algo.GetResult();
+      std::cout << std::setw(8) << islands << std::setw(12) << migration
+                << std::setw(12) << timer.Seconds() << std::setw(12)
+                << result.distance << '\n';
+    }
+  }
+}
+
+/**
+ * @brief Run time of the simulated annealing solver
+ *
+ */
+void BenchAnnealing() {
+  PrintHeader("Simulated annealing, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  for (size_t size : {50, 200, 1000}) {
+    Graph graph = MakeRandomGraph(size, 1.0, 1000, false, size);
+    Timer timer;
+    TsmResult result = GraphAlgorithms::SolveTsmSimulatedAnnealing(graph, 1);
+    std::cout << std::setw(8) << size << std::setw(12) << timer.Seconds()
+              << std::setw(12) << result.distance << '\n';
+  }
+}
+
+/**
+ * @brief Tour length and run time of the annealing modes, multi-start and
+ * tempering run eight replicas on eight threads
+ *
+ */
+void BenchAnnealingModes() {
+  PrintHeader("Simulated annealing modes on 200 vertices, seconds");
+  std::cout << std::setw(12) << "mode" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  const std::pair<const char *, AnnealingAlgorithm::Mode> modes[] = {
+      {"single", AnnealingAlgorithm::Mode::kSingle},
+      {"multistart", AnnealingAlgorithm::Mode::kMultiStart},
+      {"tempering", AnnealingAlgorithm::Mode::kTempering}};
+  Graph graph = MakeRandomGraph(200, 1.0, 1000, false, 200);
+  for (const auto &mode : modes) {
+    Timer timer;
+    AnnealingAlgorithm algo(graph, 1);
+    algo.SetMode(mode.second);
+    algo.SetReplicasCount(8);
+    algo.SetThreadsCount(8);
+    algo.RunAlgorithm();
+    TsmResult result = algo.GetResult();
+    std::cout << std::setw(12) << mode.first << std::setw(12)
+              << timer.Seconds() << std::setw(12) << result.distance << '\n';
+  }
+}
+
+/**
+ * @brief Tour length of the adaptive annealing by time budget against the
+ * fixed schedule, one chain
+ *
+ */
+void BenchAnnealingBudget() {
+  PrintHeader("Simulated annealing by time budget, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(12) << "budget"
+            << std::setw(12) << "time" << std::setw(12) << "distance" << '\n';
+  for (size_t size : {200, 1000}) {
+    Graph graph = MakeRandomGraph(size, 1.0, 1000, false, size);
+    for (double budget : {0.0, 0.1, 0.3, 1.0}) {
+      Timer timer;
+      AnnealingAlgorithm algo(graph, 1);
+      algo.SetTimeBudget(budget);
+      algo.RunAlgorithm();
+      TsmResult result = algo.GetResult();
+      std::cout << std::setw(8) << size << std::setw(12) << budget
+                << std::setw(12) << timer.Seconds() << std::setw(12)
+                << result.distance << '\n';
+    }
+  }
+}
+
+/**
+ * @brief Generations per second of the genetic algorithm
+ *
+ */
+void BenchGenetic() {
+  PrintHeader("Genetic algorithm, generations per second");
+  std::cout << std::setw(8) << "size" << std::setw(12) << "time"
+            << std::setw(14) << "generations/s" << std::setw(12) << "distance"
+            << '\n';
+  for (size_t size : {100, 1000, 5000}) {
+    Graph graph = MakeRandomGraph(size, 1.0, 1000, false, size);
+    Timer timer;
+    TsmResult result = GraphAlgorithms::SolveTsmGenetic(graph, 1);
+    double time = timer.Seconds();
+    std::cout << std::setw(8) << size << std::setw(12) << time
+              << std::setw(14) << Heuristics().kGenerationsCount / time
+              << std::setw(12) << result.distance << '\n';
+  }
+}
+
+/**
+ * @brief Tour length and run time of the crossovers on 1000 vertices with a
+ * population of 100, tournaments of 3 and all the hardware threads
+ *
+ */
+void BenchGeneticCrossovers() {
+  PrintHeader("Genetic crossovers on 1000 vertices, seconds");
+  std::cout << std::setw(10) << "crossover" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  struct Variant {
+    const char *name;
+    GeneticAlgorithm::Crossover crossover;
+    size_t mutations;
+  };
+  const Variant variants[] = {
+      {"prefix", GeneticAlgorithm::Crossover::kPrefix, 1},
+      {"OX", GeneticAlgorithm::Crossover::kOrder, 1},
+      {"PMX", GeneticAlgorithm::Crossover::kPartiallyMapped, 1},
+      {"EAX", GeneticAlgorithm::Crossover::kEdgeAssembly, 0}};
+  Graph graph = MakeRandomGraph(1000, 1.0, 1000, false, 1000);
+  for (const Variant &variant : variants) {
+    Timer timer;
+    GeneticAlgorithm algo(graph, 1);
+    algo.SetCrossover(variant.crossover);
+    algo.SetPopulationSize(100);
+    algo.SetTournamentSize(3);
+    algo.SetMutationsCount(variant.mutations);
+    algo.SetGenerationsCount(300);
+    algo.SetThreadsCount(0);
+    algo.RunAlgorithm();
+    TsmResult result = algo.GetResult();
+    std::cout << std::setw(10) << variant.name << std::setw(12)
+              << timer.Seconds() << std::setw(12) << result.distance << '\n';
+  }
+}
+
+/**
+ * @brief Tour length and run time of the genetic islands, one thread per
+ * island, with and without migration. Every island is a population of 30
+ * breeding by EAX for 200 generations.
+ *
+ */
+void BenchGeneticIslands() {
+  PrintHeader("Genetic islands on 200 vertices, seconds");
+  std::cout << std::setw(8) << "islands" << std::setw(12) << "migration"
+            << std::setw(12) << "time" << std::setw(12) << "distance"
+            << '\n';
+  Graph graph = MakeRandomGraph(200, 1.0, 1000, false, 200);
+  for (size_t islands : {1, 2, 4}) {
+    for (size_t migration : {0, 20}) {
+      Timer timer;
+      GeneticAlgorithm algo(graph, 1);
+      algo.SetCrossover(GeneticAlgorithm::Crossover::kEdgeAssembly);
+      algo.SetPopulationSize(30);
+      algo.SetTournamentSize(3);
+      algo.SetMutationsCount(0);
+      algo.SetGenerationsCount(200);
+      algo.SetIslandsCount(islands);
+      algo.SetThreadsCount(islands);
+      algo.SetMigrationInterval(migration);
+      algo.RunAlgorithm();
+      TsmResult result = algo.GetResult();
+      std::cout << std::setw(8) << islands << std::setw(12) << migration
+                << std::setw(12) << timer.Seconds() << std::setw(12)
+                << result.distance << '\n';
+    }
+  }
+}
+
+/**
+ * @brief Run time and tour length of the local search from a random tour and
+ * as a polishing stage of the solvers
+ *
+ */
+void BenchLocalSearch() {
+  PrintHeader("Local search from a random tour, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(10) << "moves"
+            << std::setw(12) << "time" << std::setw(12) << "distance"
+            << '\n';
+  for (size_t size : {200, 1000, 5000}) {
+    Graph graph = MakeRandomGraph(size, 1.0, 1000, false, size);
+    LocalSearch search(graph);
+    LocalSearch::Tour random_tour(size);
+    std::iota(random_tour.begin(), random_tour.end(), 0);
+    Random(1).Shuffle(random_tour.begin(), random_tour.end());
+    const std::pair<const char *, bool (LocalSearch::*)(LocalSearch::Tour *)
+                                      const>
+        moves[] = {{"2-opt", &LocalSearch::TwoOpt},
+                   {"Or-opt", &LocalSearch::OrOpt},
+                   {"both", &LocalSearch::Improve}};
+    for (const auto &move : moves) {
+      LocalSearch::Tour tour = random_tour;
+      Timer timer;
+      (search.*move.second)(&tour);
+      std::cout << std::setw(8) << size << std::setw(10) << move.first
+                << std::setw(12) << timer.Seconds() << std::setw(12)
+                << search.GetLength(tour) << '\n';
+    }
+  }
+  PrintHeader("Solvers on 200 vertices with local search, seconds");
+  std::cout << std::setw(10) << "solver" << std::setw(8) << "polish"
+            << std::setw(12) << "time" << std::setw(12) << "distance"
+            << '\n';
+  Graph graph = MakeRandomGraph(200, 1.0, 1000, false, 200);
+  for (bool polish : {false, true}) {
+    Timer timer;
+    AntAlgorithm algo(graph, 1);
+    algo.SetMode(AntAlgorithm::Mode::kMaxMin);
+    algo.SetIterationsCount(100);
+    algo.SetLocalSearch(polish);
+    algo.RunAlgorithm();
+    std::cout << std::setw(10) << "ant" << std::setw(8) << polish
+              << std::setw(12) << timer.Seconds() << std::setw(12)
+              << algo.GetResult().distance << '\n';
+  }
+  for (bool polish : {false, true}) {
+    Timer timer;
+    AnnealingAlgorithm algo(graph, 1);
+    algo.SetLocalSearch(polish);
+    algo.RunAlgorithm();
+    std::cout << std::setw(10) << "annealing" << std::setw(8) << polish
+              << std::setw(12) << timer.Seconds() << std::setw(12)
+              << algo.GetResult().distance << '\n';
+  }
+  for (bool polish : {false, true}) {
+    Timer timer;
+    GeneticAlgorithm algo(graph, 1);
+    algo.SetCrossover(GeneticAlgorithm::Crossover::kOrder);
+    algo.SetPopulationSize(30);
+    algo.SetTournamentSize(3);
+    algo.SetMutationsCount(1);
+    algo.SetGenerationsCount(100);
+    algo.SetLocalSearch(polish);
+    algo.RunAlgorithm();
+    std::cout << std::setw(10) << "genetic" << std::setw(8) << polish
+              << std::setw(12) << timer.Seconds() << std::setw(12)
+              << algo.GetResult().distance << '\n';
+  }
+}
+
+/**
+ * @brief Tour length and run time of Lin-Kernighan with and without kicks,
+ * and of all the solvers on 200 vertices within about a second
+ *
+ */
+void BenchLinKernighan() {
+  PrintHeader("Lin-Kernighan algorithm, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(10) << "directed"
+            << std::setw(8) << "kicks" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  for (size_t size : {200, 1000}) {
+    for (bool directed : {false, true}) {
+      Graph graph = MakeRandomGraph(size, 1.0, 1000, directed, size);
+      for (size_t kicks : {size_t{0}, size}) {
+        Timer timer;
+        LinKernighanAlgorithm algo(graph, 1);
+        algo.SetKicksCount(kicks);
+        algo.RunAlgorithm();
+        std::cout << std::setw(8) << size << std::setw(10) << directed
+                  << std::setw(8) << kicks << std::setw(12) << timer.Seconds()
+                  << std::setw(12) << algo.GetResult().distance << '\n';
+      }
+    }
+  }
+  PrintHeader("Solvers on 200 vertices within a second, seconds");
+  std::cout << std::setw(14) << "solver" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  Graph graph = MakeRandomGraph(200, 1.0, 1000, false, 200);
+  {
+    Timer timer;
+    AntAlgorithm algo(graph, 1);
+    algo.SetMode(AntAlgorithm::Mode::kMaxMin);
+    algo.SetIterationsCount(100);
+    algo.SetLocalSearch(true);
+    algo.RunAlgorithm();
+    std::cout << std::setw(14) << "ant" << std::setw(12) << timer.Seconds()
+              << std::setw(12) << algo.GetResult().distance << '\n';
+  }
+  {
+    Timer timer;
+    AnnealingAlgorithm algo(graph, 1);
+    algo.SetTimeBudget(1.0);
+    algo.SetLocalSearch(true);
+    algo.RunAlgorithm();
+    std::cout << std::setw(14) << "annealing" << std::setw(12)
+              << timer.Seconds() << std::setw(12) << algo.GetResult().distance
+              << '\n';
+  }
+  {
+    Timer timer;
+    GeneticAlgorithm algo(graph, 1);
+    algo.SetCrossover(GeneticAlgorithm::Crossover::kEdgeAssembly);
+    algo.SetPopulationSize(30);
+    algo.SetTournamentSize(3);
+    algo.SetGenerationsCount(100);
+    algo.SetLocalSearch(true);
+    algo.RunAlgorithm();
+    std::cout << std::setw(14) << "genetic" << std::setw(12)
+              << timer.Seconds() << std::setw(12) << algo.GetResult().distance
+              << '\n';
+  }
+  {
+    Timer timer;
+    LinKernighanAlgorithm algo(graph, 1);
+    algo.SetKicksCount(0);
+    algo.SetTimeLimit(1.0);
+    algo.RunAlgorithm();
+    std::cout << std::setw(14) << "lin-kernighan" << std::setw(12)
+              << timer.Seconds() << std::setw(12) << algo.GetResult().distance
+              << '\n';
+  }
+}
+
+/**
+ * @brief Run time of the exact solvers against the ant colony. Branch and
+ * bound stops after kExactSeconds, the optimal column shows whether the
+ * tour is proven optimal.
+ *
+ */
+void BenchExactTsm() {
+  PrintHeader("Exact solvers, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(10) << "directed"
+            << std::setw(14) << "solver" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << std::setw(10) << "optimal"
+            << '\n';
+  auto print = [](size_t size, bool directed, const char *name, double time,
+                  double distance, bool optimal) {
+    std::cout << std::setw(8) << size << std::setw(10) << directed
+              << std::setw(14) << name << std::setw(12) << time
+              << std::setw(12) << distance << std::setw(10) << optimal
+              << '\n';
+  };
+  for (size_t size : {10, 15, 20, 25, 30}) {
+    for (bool directed : {false, true}) {
+      Graph graph = MakeRandomGraph(size, 1.0, 1000, directed, size);
+      if (size <= Heuristics().kHeldKarpSize) {
+        Timer timer;
+        TsmResult result = GraphAlgorithms::SolveTsmHeldKarp(graph);
+        print(size, directed, "held-karp", timer.Seconds(), result.distance,
+              true);
+      }
+      {
+        Timer timer;
+        BranchAndBoundAlgorithm algo(graph);
+        algo.SetTimeLimit(Heuristics().kExactSeconds);
+        algo.RunAlgorithm();
+        print(size, directed, "branch-bound", timer.Seconds(),
+              algo.GetResult().distance, algo.IsOptimal());
+      }
+      {
+        Timer timer;
+        AntAlgorithm algo(graph, 1);
+        algo.RunAlgorithm();
+        print(size, directed, "ant", timer.Seconds(),
+              algo.GetResult().distance, false);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Lengths and times of the constructive heuristics against a random
+ * tour on random weights and on points of the plane, the only input of the
+ * space-filling curve
+ *
+ */
+void BenchTourConstruction() {
+  PrintHeader("Tour construction, seconds");
+  std::cout << std::setw(8) << "size" << std::setw(10) << "graph"
+            << std::setw(14) << "heuristic" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  for (size_t size : {200, 1000}) {
+    for (std::string kind : {"random", "directed", "plane"}) {
+      std::vector<TourConstruction::Point> points;
+      Graph graph = kind == "plane"
+                        ? MakeEuclideanGraph(size, 1000.0, size, &points)
+                        : MakeRandomGraph(size, 1.0, 1000, kind == "directed",
+                                          size);
+      TourConstruction construction(graph);
+      auto print = [&](const char *name, auto build) {
+        Timer timer;
+        TourConstruction::Tour tour = build();
+        double time = timer.Seconds();
+        std::cout << std::setw(8) << size << std::setw(10) << kind
+                  << std::setw(14) << name << std::setw(12) << time
+                  << std::setw(12) << construction.GetLength(tour) << '\n';
+      };
+      print("random", [size] {
+        TourConstruction::Tour tour(size);
+        std::iota(tour.begin(), tour.end(), 0);
+        Random(1).Shuffle(tour.begin(), tour.end());
+        return tour;
+      });
+      print("nearest", [&] { return construction.NearestNeighbour(); });
+      print("greedy", [&] { return construction.GreedyEdge(); });
+      print("christofides", [&] { return construction.Christofides(); });
+      if (kind != "plane") continue;
+      print("hilbert",
+            [&] { return TourConstruction::SpaceFillingCurve(points); });
+    }
+  }
+}
+
+/**
+ * @brief Time to quality of the solvers from random tours and from greedy
+ * edge tours on 1000 vertices, the time of a warm start takes in the
+ * construction
+ *
+ */
+void BenchWarmStart() {
+  PrintHeader("Warm starts on 1000 vertices, seconds");
+  std::cout << std::setw(14) << "solver" << std::setw(8) << "warm"
+            << std::setw(10) << "budget" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << '\n';
+  Graph graph = MakeRandomGraph(1000, 1.0, 1000, false, 1000);
+  auto print = [](const char *name, bool warm, double budget, double time,
+                  double distance) {
+    std::cout << std::setw(14) << name << std::setw(8) << warm
+              << std::setw(10) << budget << std::setw(12) << time
+              << std::setw(12) << distance << '\n';
+  };
+  for (bool warm : {false, true}) {
+    for (double budget : {0.1, 0.3, 1.0}) {
+      Timer timer;
+      AnnealingAlgorithm algo(graph, 1);
+      if (warm) algo.SetInitialTour(TourConstruction(graph).GreedyEdge());
+      algo.SetTimeBudget(budget);
+      algo.RunAlgorithm();
+      print("annealing", warm, budget, timer.Seconds(),
+            algo.GetResult().distance);
+    }
+  }
+  for (bool warm : {false, true}) {
+    for (size_t iterations : {10, 30}) {
+      Timer timer;
+      AntAlgorithm algo(graph, 1);
+      if (warm) algo.SetInitialTour(TourConstruction(graph).GreedyEdge());
+      algo.SetMode(AntAlgorithm::Mode::kMaxMin);
+      algo.SetIterationsCount(iterations);
+      algo.RunAlgorithm();
+      print("ant", warm, iterations, timer.Seconds(),
+            algo.GetResult().distance);
+    }
+  }
+  for (bool warm : {false, true}) {
+    for (size_t generations : {100, 300, 1000}) {
+      Timer timer;
+      GeneticAlgorithm algo(graph, 1);
+      if (warm) algo.SetInitialTour(TourConstruction(graph).GreedyEdge());
+      algo.SetCrossover(GeneticAlgorithm::Crossover::kEdgeAssembly);
+      algo.SetPopulationSize(30);
+      algo.SetTournamentSize(3);
+      algo.SetMutationsCount(0);
+      algo.SetGenerationsCount(generations);
+      algo.RunAlgorithm();
+      print("genetic", warm, generations, timer.Seconds(),
+            algo.GetResult().distance);
+    }
+  }
+  for (bool warm : {false, true}) {
+    Timer timer;
+    LinKernighanAlgorithm algo(graph, 1);
+    if (warm) algo.SetInitialTour(TourConstruction(graph).GreedyEdge());
+    algo.SetKicksCount(0);
+    algo.RunAlgorithm();
+    print("lin-kernighan", warm, 0, timer.Seconds(),
+          algo.GetResult().distance);
+  }
+}
+
+/**
+ * @brief Tour length, lower bound and winner of the portfolio by deadline
+ * and target gap, with a single engine and with all the default ones
+ *
+ */
+void BenchPortfolio() {
+  PrintHeader("Portfolio on 1000 vertices, seconds");
+  std::cout << std::setw(14) << "engines" << std::setw(10) << "budget"
+            << std::setw(8) << "gap" << std::setw(12) << "time"
+            << std::setw(12) << "distance" << std::setw(12) << "bound"
+            << std::setw(10) << "winner" << '\n';
+  using Engine = PortfolioSolver::Engine;
+  Graph graph = MakeRandomGraph(1000, 1.0, 1000, false, 1000);
+  std::vector<std::pair<const char *, std::vector<Engine>>> portfolios = {
+      {"annealing", {Engine::kAnnealing}},
+      {"lin-kernighan", {Engine::kLinKernighan}},
+      {"all", {}}};
+  for (const auto &[name, engines] : portfolios) {
+    for (double budget : {0.3, 1.0}) {
+      for (double gap : {0.0, 0.05}) {
+        Timer timer;
+        PortfolioSolver algo(graph, 1);
+        algo.SetEngines(engines);
+        algo.SetTimeLimit(budget);
+        algo.SetTargetGap(gap);
+        algo.RunAlgorithm();
+        std::cout << std::setw(14) << name << std::setw(10) << budget
+                  << std::setw(8) << gap << std::setw(12) << timer.Seconds()
+                  << std::setw(12) << algo.GetResult().distance
+                  << std::setw(12) << algo.GetLowerBound() << std::setw(10)
+                  << static_cast<int>(algo.GetWinner()) << '\n';
+      }
+    }
+  }
+}
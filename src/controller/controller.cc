@@ -20,7 +20,7 @@ int Controller::FourthItem(int vertex1, int vertex2) {
 
 GraphAlgorithms::Matrix Controller::FivthItem() { return model_->FivthItem(); }
 
-GraphAlgorithms::Matrix Controller::SixthItem() { return model_->SixthItem(); }
+MstResult Controller::SixthItem() { return model_->SixthItem(); }
 
 TsmResult Controller::SeventhItem() { return model_->SeventhItem(); }
 
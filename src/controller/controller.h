@@ -12,7 +12,7 @@ class Controller {
   GraphAlgorithms::Vector ThirdItem(int start);
   int FourthItem(int vertex1, int vertex2);
   GraphAlgorithms::Matrix FivthItem();
-  GraphAlgorithms::Matrix SixthItem();
+  MstResult SixthItem();
   TsmResult SeventhItem();
   std::vector<std::pair<double, double>> EighthItem(int cycles);
 
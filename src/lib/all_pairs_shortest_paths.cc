@@ -0,0 +1,190 @@
+#include "all_pairs_shortest_paths.h"
+
+#include <stdexcept>
+
+/**
+ * @brief Construct a new All Pairs Shortest Paths:: All Pairs Shortest Paths
+ * object. The adjacency matrix is copied, later changes go through UpdateEdge.
+ *
+ * @param graph
+ */
+AllPairsShortestPaths::AllPairsShortestPaths(const Graph &graph)
+    : graph_{graph.GetGraph()} {}
+
+/**
+ * @brief Computes all the distances and predecessors from scratch by the
+ * Floyd-Warshall algorithm
+ *
+ */
+void AllPairsShortestPaths::RunAlgorithm() {
+  const size_t size = graph_.size();
+  distance_ = Matrix(size, std::vector<int>(size, kInfinity));
+  predecessor_ = Matrix(size, std::vector<int>(size, -1));
+  for (size_t i = 0; i < size; ++i) {
+    distance_[i][i] = 0;
+    for (size_t j = 0; j < size; ++j) {
+      if (i != j && graph_[i][j] != 0) {
+        distance_[i][j] = graph_[i][j];
+        predecessor_[i][j] = i;
+      }
+    }
+  }
+  for (size_t k = 0; k < size; ++k) {
+    for (size_t i = 0; i < size; ++i) {
+      if (distance_[i][k] == kInfinity) continue;
+      for (size_t j = 0; j < size; ++j) {
+        if (distance_[k][j] == kInfinity) continue;
+        int distance = distance_[i][k] + distance_[k][j];
+        if (distance < distance_[i][j]) {
+          distance_[i][j] = distance;
+          predecessor_[i][j] = predecessor_[k][j];
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Sets weight of the (vertex1, vertex2) edge and patches the distances.
+ * A decrease is applied to every pair in O(n^2). An increase or a removal
+ * recomputes only the rows whose shortest path tree uses the edge, O(n^2)
+ * per row.
+ *
+ * @param vertex1 Zero-based edge start
+ * @param vertex2 Zero-based edge end
+ * @param weight New weight, 0 removes the edge
+ */
+void AllPairsShortestPaths::UpdateEdge(int vertex1, int vertex2, int weight) {
+  CheckVertex(vertex1);
+  CheckVertex(vertex2);
+  if (weight < 0) throw std::logic_error("Negative edge weight");
+  int old_weight = graph_[vertex1][vertex2];
+  graph_[vertex1][vertex2] = weight;
+  if (distance_.empty() || vertex1 == vertex2 || weight == old_weight) return;
+  if (weight != 0 && (old_weight == 0 || weight < old_weight)) {
+    DecreaseEdge(vertex1, vertex2, weight);
+  } else {
+    for (size_t i = 0; i < graph_.size(); ++i) {
+      if (predecessor_[i][vertex2] == vertex1) RecomputeRow(i);
+    }
+  }
+}
+
+/**
+ * @brief Returns the matrix of the shortest paths with the contract of
+ * GraphAlgorithms::GetShortestPathsBetweenAllVertices: 0 for unreachable
+ * vertices, on the diagonal the shortest cycle for vertices with a loop
+ *
+ * @return AllPairsShortestPaths::Matrix
+ */
+AllPairsShortestPaths::Matrix AllPairsShortestPaths::GetResult() const {
+  const size_t size = graph_.size();
+  Matrix m(size, std::vector<int>(size));
+  for (size_t i = 0; i < distance_.size(); ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      if (i != j && distance_[i][j] != kInfinity) m[i][j] = distance_[i][j];
+    }
+    if (graph_[i][i] == 0) continue;
+    m[i][i] = graph_[i][i];
+    for (size_t v = 0; v < size; ++v) {
+      if (v != i && graph_[i][v] != 0 && distance_[v][i] != kInfinity) {
+        m[i][i] = std::min(m[i][i], graph_[i][v] + distance_[v][i]);
+      }
+    }
+  }
+  return m;
+}
+
+/**
+ * @brief Returns the shortest distance, -1 if vertex2 is unreachable
+ *
+ * @param vertex1 Zero-based starting vertex
+ * @param vertex2 Zero-based final vertex
+ * @return int
+ */
+int AllPairsShortestPaths::GetDistance(int vertex1, int vertex2) const {
+  CheckVertex(vertex1);
+  CheckVertex(vertex2);
+  int distance = distance_[vertex1][vertex2];
+  return distance == kInfinity ? -1 : distance;
+}
+
+/**
+ * @brief Returns the vertex preceding vertex2 on the shortest path from
+ * vertex1, -1 if there is no such path
+ *
+ * @param vertex1 Zero-based starting vertex
+ * @param vertex2 Zero-based final vertex
+ * @return int
+ */
+int AllPairsShortestPaths::GetPredecessor(int vertex1, int vertex2) const {
+  CheckVertex(vertex1);
+  CheckVertex(vertex2);
+  return predecessor_[vertex1][vertex2];
+}
+
+/**
+ * @brief Relaxes every pair through the cheaper edge. Distances to vertex1
+ * and from vertex2 can not go through the edge, so they stay valid while the
+ * matrix is patched in place.
+ *
+ * @param vertex1
+ * @param vertex2
+ * @param weight
+ */
+void AllPairsShortestPaths::DecreaseEdge(int vertex1, int vertex2,
+                                         int weight) {
+  const std::vector<int> &from = distance_[vertex2];
+  const std::vector<int> &from_predecessor = predecessor_[vertex2];
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    if (distance_[i][vertex1] == kInfinity) continue;
+    int via = distance_[i][vertex1] + weight;
+    if (via >= distance_[i][vertex2]) continue;
+    for (size_t j = 0; j < graph_.size(); ++j) {
+      if (from[j] == kInfinity || via + from[j] >= distance_[i][j]) continue;
+      distance_[i][j] = via + from[j];
+      predecessor_[i][j] =
+          static_cast<int>(j) == vertex2 ? vertex1 : from_predecessor[j];
+    }
+  }
+}
+
+/**
+ * @brief Recomputes a row of distances and predecessors by Dijkstra's
+ * algorithm over the adjacency matrix
+ *
+ * @param vertex Zero-based starting vertex
+ */
+void AllPairsShortestPaths::RecomputeRow(int vertex) {
+  const size_t size = graph_.size();
+  std::vector<int> &distance = distance_[vertex];
+  std::vector<int> &predecessor = predecessor_[vertex];
+  std::fill(distance.begin(), distance.end(), kInfinity);
+  std::fill(predecessor.begin(), predecessor.end(), -1);
+  std::vector<bool> settled(size);
+  distance[vertex] = 0;
+  for (size_t step = 0; step < size; ++step) {
+    int current = -1;
+    for (size_t v = 0; v < size; ++v) {
+      if (!settled[v] && distance[v] != kInfinity &&
+          (current == -1 || distance[v] < distance[current])) {
+        current = v;
+      }
+    }
+    if (current == -1) break;
+    settled[current] = true;
+    for (size_t v = 0; v < size; ++v) {
+      if (settled[v] || graph_[current][v] == 0) continue;
+      if (distance[current] + graph_[current][v] < distance[v]) {
+        distance[v] = distance[current] + graph_[current][v];
+        predecessor[v] = current;
+      }
+    }
+  }
+}
+
+void AllPairsShortestPaths::CheckVertex(int vertex) const {
+  if (vertex < 0 || vertex >= static_cast<int>(graph_.size())) {
+    throw std::out_of_range("Graph index out of range");
+  }
+}
@@ -0,0 +1,38 @@
+#ifndef SRC_LIB_ALL_PAIRS_SHORTEST_PATHS_H
+#define SRC_LIB_ALL_PAIRS_SHORTEST_PATHS_H
+
+#include <limits>
+#include <vector>
+
+#include "s21_graph.h"
+
+/**
+ * @brief Shortest paths between all vertices with predecessors, kept up to
+ * date on single edge weight changes without full recomputation
+ *
+ */
+class AllPairsShortestPaths {
+ public:
+  using Matrix = std::vector<std::vector<int>>;
+
+  explicit AllPairsShortestPaths(const Graph &);
+
+  void RunAlgorithm();
+  void UpdateEdge(int vertex1, int vertex2, int weight);
+  Matrix GetResult() const;
+  int GetDistance(int vertex1, int vertex2) const;
+  int GetPredecessor(int vertex1, int vertex2) const;
+
+ private:
+  void DecreaseEdge(int vertex1, int vertex2, int weight);
+  void RecomputeRow(int vertex);
+  void CheckVertex(int vertex) const;
+
+  static constexpr int kInfinity = std::numeric_limits<int>::max();
+
+  Matrix graph_;
+  Matrix distance_;
+  Matrix predecessor_;
+};
+
+#endif  // SRC_LIB_ALL_PAIRS_SHORTEST_PATHS_H
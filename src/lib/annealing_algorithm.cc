@@ -1,44 +1,453 @@
 #include "./annealing_algorithm.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "tour_construction.h"
+
 /**
  * @brief Construct a new Annealing Algorithm:: Annealing Algorithm object
  *
  * @param graph
+ * @param seed Seed of the random generator, replicas get independent streams
  */
-AnnealingAlgorithm::AnnealingAlgorithm(const Graph &graph)
-    : graph_(graph.GetGraph()) {}
+AnnealingAlgorithm::AnnealingAlgorithm(const Graph &graph, uint64_t seed)
+    : graph_(graph.GetGraph()),
+      source_(graph),
+      seed_(seed),
+      symmetric_(!graph.IsDirected()),
+      replicas_(consts_.kReplicas) {}
 
 /**
- * @brief Runs Annealing Algotithm on loaded graph
+ * @brief Runs Annealing Algotithm on loaded graph in the chosen mode. Every
+ * run takes a new stream of the seed, so repeated runs give different tours.
  *
  */
 void AnnealingAlgorithm::RunAlgorithm() {
-  double temperature = consts_.kStartTemp;
-  int attempts = graph_.size() * consts_.kAttempts;
-  TsmResult random_result{{}, 0};
-  random_result.vertices = RandomPath();
-  random_result.distance = GetDistance(random_result);
-  result_ = random_result;
-  while (temperature > consts_.kMinTemp) {
-    for (int i = 0; i < attempts; ++i) {
-      random_result = Shuffle(random_result);
-      random_result.distance = GetDistance(random_result);
-      if (MakeDecision(result_, random_result, temperature)) {
-        result_ = random_result;
-      } else {
-        random_result = result_;
+  run_seed_ = Random::DeriveRun(seed_, runs_++);
+  size_t threads = mode_ == Mode::kSingle ? 1 : std::min(threads_, replicas_);
+  if (threads > 1) pool_ = std::make_unique<ThreadPool>(threads);
+  if (mode_ == Mode::kSingle) {
+    RunSingle();
+  } else if (mode_ == Mode::kMultiStart) {
+    RunMultiStart();
+  } else {
+    RunTempering();
+  }
+  pool_.reset();
+  if (polish_ && LocalSearch(source_).Polish(&result_)) {
+    Report(result_.vertices);
+  }
+}
+
+/**
+ * @brief Sets variant of the algorithm
+ *
+ * @param mode
+ */
+void AnnealingAlgorithm::SetMode(Mode mode) { mode_ = mode; }
+
+/**
+ * @brief Sets number of threads running the replicas, 0 - number of hardware
+ * threads. Replicas do not depend on the threads, so equal seeds and equal
+ * numbers of replicas give equal results.
+ *
+ * @param threads
+ */
+void AnnealingAlgorithm::SetThreadsCount(size_t threads) {
+  threads_ = threads ? threads : ThreadPool::DefaultThreadsCount();
+}
+
+/**
+ * @brief Sets number of chains of the multi-start and tempering modes,
+ * kReplicas by default
+ *
+ * @param replicas
+ */
+void AnnealingAlgorithm::SetReplicasCount(size_t replicas) {
+  replicas_ = std::max<size_t>(1, replicas);
+}
+
+/**
+ * @brief Sets wall-clock budget of the run, 0 - no limit. With a budget the
+ * chains cool down adaptively and stop when it is spent.
+ *
+ * @param seconds
+ */
+void AnnealingAlgorithm::SetTimeBudget(double seconds) {
+  time_budget_ = std::max(0.0, seconds);
+}
+
+/**
+ * @brief Sets number of attempts of every chain, 0 - no limit. With a budget
+ * the chains cool down adaptively and stop when it is spent.
+ *
+ * @param attempts
+ */
+void AnnealingAlgorithm::SetAttemptsBudget(size_t attempts) {
+  attempts_budget_ = attempts;
+}
+
+/**
+ * @brief Enables 2-opt and Or-opt improvement of the final tour
+ *
+ * @param enabled
+ */
+void AnnealingAlgorithm::SetLocalSearch(bool enabled) { polish_ = enabled; }
+
+/**
+ * @brief Sets the tour the chains start from instead of random ones, an
+ * empty tour brings the random ones back. Warm chains start cooler, so they
+ * refine the tour instead of losing it.
+ *
+ * @param tour Zero-based permutation of the vertices
+ */
+void AnnealingAlgorithm::SetInitialTour(const Vector &tour) {
+  if (!tour.empty() && !TourConstruction::IsTour(tour, graph_.size())) {
+    throw std::logic_error("The initial tour is not a permutation of vertices");
+  }
+  initial_ = tour;
+}
+
+/**
+ * @brief Sets the token stopping the run, nullptr - the run is not stopped.
+ * A cancelled run stops after the current epoch with the best tour found.
+ *
+ * @param token Token outliving the run
+ */
+void AnnealingAlgorithm::SetCancellationToken(const CancellationToken *token) {
+  token_ = token;
+}
+
+/**
+ * @brief Sets the callback getting every new best tour of a chain, chains
+ * running in different threads may call it concurrently
+ *
+ * @param callback
+ */
+void AnnealingAlgorithm::SetProgressCallback(TsmCallback callback) {
+  callback_ = std::move(callback);
+}
+
+/**
+ * @brief Cools down one chain
+ *
+ */
+void AnnealingAlgorithm::RunSingle() {
+  Chain chain(*this, run_seed_);
+  result_ = Cool(&chain, time_budget_);
+}
+
+/**
+ * @brief Cools down independent chains concurrently, the result is the best
+ * of their tours. Chains beyond the number of threads run in later waves, so
+ * a time budget is shared between the waves.
+ *
+ */
+void AnnealingAlgorithm::RunMultiStart() {
+  std::vector<Chain> chains;
+  for (size_t i = 0; i < replicas_; ++i) {
+    chains.emplace_back(*this, Random::Derive(run_seed_, i));
+  }
+  size_t threads = pool_ ? pool_->GetThreadsCount() : 1;
+  double seconds = time_budget_ / ((replicas_ + threads - 1) / threads);
+  std::vector<TsmResult> results(chains.size());
+  ForEach(chains.size(), [this, &chains, &results, seconds](size_t i) {
+    results[i] = Cool(&chains[i], seconds);
+  });
+  result_ = *std::min_element(results.begin(), results.end(),
+                              [](const TsmResult &x, const TsmResult &y) {
+                                return x.distance < y.distance;
+                              });
+}
+
+/**
+ * @brief Parallel tempering: replicas stay at temperatures spread
+ * geometrically from the mean edge weight down to kColdRatio of it, where
+ * moves are judged on the scale of the graph, and run concurrently, each as
+ * many attempts as the cooling chain or until the budget is spent. The
+ * budget and the token are checked every max(n, 100) attempts within a
+ * level, as in CoolWithin. After every level of attempts the neighbouring
+ * replicas i and i + 1, odd or even pairs in turn, exchange their tours with
+ * probability min(1, exp((1 / T_i - 1 / T_i+1) * (L_i - L_i+1))). The result
+ * is the best tour seen at these exchanges.
+ *
+ */
+void AnnealingAlgorithm::RunTempering() {
+  double weights = 0.0, edges = 0.0;
+  for (const auto &row : graph_) {
+    for (int weight : row) {
+      if (weight) {
+        weights += weight;
+        ++edges;
+      }
+    }
+  }
+  double hot = edges > 0 ? weights / edges : 1.0;
+  std::vector<Chain> chains;
+  std::vector<double> temperatures;
+  for (size_t i = 0; i < replicas_; ++i) {
+    chains.emplace_back(*this, Random::Derive(run_seed_, i));
+    double share = replicas_ > 1 ? static_cast<double>(i) / (replicas_ - 1) : 1;
+    temperatures.push_back(hot * std::pow(consts_.kColdRatio, share));
+  }
+  Random random(Random::Derive(run_seed_, replicas_));
+  const int attempts = graph_.size() * consts_.kAttempts;
+  const int epoch = std::max<int>(graph_.size(), 100);
+  result_ = TsmResult{chains.front().GetTour(), chains.front().GetDistance()};
+  size_t levels = 0;
+  for (double t = consts_.kStartTemp; t > consts_.kMinTemp;
+       t *= consts_.kDecrease) {
+    ++levels;
+  }
+  Clock::time_point start = Clock::now();
+  for (size_t level = 0; !IsCancelled(); ++level) {
+    if (HasBudget() ? GetProgress(start, level * attempts, time_budget_) >= 1
+                    : level == levels) {
+      break;
+    }
+    ForEach(chains.size(), [&](size_t i) {
+      for (int done = 0; done < attempts && !IsCancelled(); done += epoch) {
+        if (HasBudget() && GetProgress(start, level * attempts + done,
+                                       time_budget_) >= 1) {
+          break;
+        }
+        chains[i].Run(temperatures[i], std::min(epoch, attempts - done));
+      }
+    });
+    for (const Chain &chain : chains) {
+      if (chain.GetDistance() < result_.distance) {
+        result_ = TsmResult{chain.GetTour(), chain.GetDistance()};
+        Report(result_.vertices);
+      }
+    }
+    for (size_t i = level % 2; i + 1 < chains.size(); i += 2) {
+      double exponent = (1 / temperatures[i] - 1 / temperatures[i + 1]) *
+                        (chains[i].GetDistance() - chains[i + 1].GetDistance());
+      if (exponent >= 0 || random.NextDouble() < std::exp(exponent)) {
+        chains[i].Exchange(&chains[i + 1]);
       }
     }
-    temperature *= consts_.kDecrease;
   }
 }
 
+/**
+ * @brief Runs the chain from kStartTemp, or kColdRatio of it from an initial
+ * tour, down to kMinTemp, multiplying the temperature by kDecrease after
+ * every n * kAttempts attempts, the result is the final tour. With a budget
+ * the chain cools down by CoolWithin.
+ *
+ * @param chain
+ * @param seconds Time budget of the chain, 0 - no limit
+ * @return TsmResult
+ */
+TsmResult AnnealingAlgorithm::Cool(Chain *chain, double seconds) const {
+  if (HasBudget()) return CoolWithin(chain, seconds);
+  int attempts = graph_.size() * consts_.kAttempts;
+  double hot = consts_.kStartTemp;
+  if (!initial_.empty()) hot *= consts_.kColdRatio;
+  double best = std::numeric_limits<double>::infinity();
+  for (double t = hot; t > consts_.kMinTemp && !IsCancelled();
+       t *= consts_.kDecrease) {
+    chain->Run(t, attempts);
+    if (chain->GetDistance() < best) {
+      best = chain->GetDistance();
+      Report(chain->GetTour());
+    }
+  }
+  return TsmResult{chain->GetTour(), chain->GetDistance()};
+}
+
+/**
+ * @brief Cools the chain down within the budget. The start temperature makes
+ * an average uphill move of a random walk accepted with chance 1/2, so it
+ * follows the scale of the weights. The temperature falls geometrically with
+ * the spent share of the budget down to kColdRatio^2 of the start, so the
+ * schedule stretches or shrinks to the budget. A chain from an initial tour
+ * takes the sample on a copy and falls from kColdRatio of the start, so the
+ * tour is not scrambled. The result is the best tour seen between epochs.
+ *
+ * @param chain
+ * @param seconds Time budget of the chain, 0 - no limit
+ * @return TsmResult
+ */
+TsmResult AnnealingAlgorithm::CoolWithin(Chain *chain, double seconds) const {
+  const int epoch = std::max<int>(graph_.size(), 100);
+  Clock::time_point start = Clock::now();
+  const double infinity = std::numeric_limits<double>::infinity();
+  Chain::Counters sample = initial_.empty()
+                               ? chain->Run(infinity, epoch)
+                               : Chain(*chain).Run(infinity, epoch);
+  double hot =
+      sample.uphill ? sample.uphill_sum / sample.uphill / std::log(2.0) : 1.0;
+  double ratio = consts_.kColdRatio * consts_.kColdRatio;
+  if (!initial_.empty()) {
+    hot *= consts_.kColdRatio;
+    ratio = consts_.kColdRatio;
+  }
+  TsmResult best{chain->GetTour(), chain->GetDistance()};
+  size_t attempts = epoch;
+  for (double progress = GetProgress(start, attempts, seconds);
+       progress < 1.0 && !IsCancelled();
+       progress = GetProgress(start, attempts, seconds)) {
+    chain->Run(hot * std::pow(ratio, progress), epoch);
+    attempts += epoch;
+    if (chain->GetDistance() < best.distance) {
+      best = TsmResult{chain->GetTour(), chain->GetDistance()};
+      Report(best.vertices);
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Returns true if a time or attempts budget is set
+ *
+ * @return true
+ * @return false
+ */
+bool AnnealingAlgorithm::HasBudget() const {
+  return time_budget_ > 0.0 || attempts_budget_ > 0;
+}
+
+/**
+ * @brief Returns spent share of the budget, the larger of the time and the
+ * attempts shares
+ *
+ * @param start Start of the run
+ * @param attempts Attempts made by a chain
+ * @param seconds Time budget, 0 - no limit
+ * @return double
+ */
+double AnnealingAlgorithm::GetProgress(Clock::time_point start,
+                                       size_t attempts, double seconds) const {
+  double progress = 0.0;
+  if (seconds > 0.0) {
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    progress = elapsed.count() / seconds;
+  }
+  if (attempts_budget_ > 0) {
+    progress = std::max(progress, static_cast<double>(attempts) /
+                                      attempts_budget_);
+  }
+  return progress;
+}
+
+/**
+ * @brief Calls body for every index in [0, count), on the pool if there is one
+ *
+ * @param count
+ * @param body
+ */
+void AnnealingAlgorithm::ForEach(size_t count,
+                                 const std::function<void(size_t)> &body) {
+  if (pool_) {
+    pool_->ParallelFor(count, [&body](size_t i, size_t) { body(i); });
+  } else {
+    for (size_t i = 0; i < count; ++i) body(i);
+  }
+}
+
+/**
+ * @brief Returns true if the token of the run is cancelled
+ *
+ * @return true
+ * @return false
+ */
+bool AnnealingAlgorithm::IsCancelled() const {
+  return token_ && token_->IsCancelled();
+}
+
+/**
+ * @brief Passes the tour to the callback with its length if it has no
+ * missing edges, the chains count them as free
+ *
+ * @param tour
+ */
+void AnnealingAlgorithm::Report(const Vector &tour) const {
+  if (!callback_) return;
+  double length = TourConstruction::GetLength(source_, tour);
+  if (length != std::numeric_limits<double>::infinity()) {
+    callback_(TsmResult{tour, length});
+  }
+}
+
+/**
+ * @brief Construct a new Annealing Algorithm:: Chain:: Chain object starting
+ * from the initial tour of the algorithm or a random one
+ *
+ * @param algo Algorithm sharing the graph
+ * @param seed Seed of the generator of the chain
+ */
+AnnealingAlgorithm::Chain::Chain(const AnnealingAlgorithm &algo, uint64_t seed)
+    : graph_(algo.graph_), symmetric_(algo.symmetric_), random_(seed) {
+  tour_ = algo.initial_.empty() ? RandomPath() : algo.initial_;
+  distance_ = GetDistance(tour_);
+}
+
+/**
+ * @brief Makes the attempts at the temperature. Every attempt picks a random
+ * move: a swap of two vertices, a reversal of a path (2-opt, on undirected
+ * graphs only) or a transfer of a path of up to three vertices (or-opt). A
+ * move is judged by the change of the tour length in O(1), only accepted
+ * moves touch the tour.
+ *
+ * @param temperature
+ * @param attempts
+ * @return AnnealingAlgorithm::Chain::Counters
+ */
+AnnealingAlgorithm::Chain::Counters AnnealingAlgorithm::Chain::Run(
+    double temperature, int attempts) {
+  counters_ = Counters();
+  if (graph_.size() <= 3) return counters_;
+  int moves = symmetric_ ? 3 : 2;
+  for (int i = 0; i < attempts; ++i) {
+    int move = RandomChoice(moves - 1);
+    if (move == 0) {
+      TrySwap(temperature);
+    } else if (move == 1) {
+      TryOrOpt(temperature);
+    } else {
+      TryTwoOpt(temperature);
+    }
+  }
+  return counters_;
+}
+
+/**
+ * @brief Returns length of the tour of the chain
+ *
+ * @return double
+ */
+double AnnealingAlgorithm::Chain::GetDistance() const { return distance_; }
+
+/**
+ * @brief Returns the tour of the chain
+ *
+ * @return const AnnealingAlgorithm::Vector&
+ */
+const AnnealingAlgorithm::Vector &AnnealingAlgorithm::Chain::GetTour() const {
+  return tour_;
+}
+
+/**
+ * @brief Exchanges tours with the other chain, the generators stay
+ *
+ * @param other
+ */
+void AnnealingAlgorithm::Chain::Exchange(Chain *other) {
+  tour_.swap(other->tour_);
+  std::swap(distance_, other->distance_);
+}
+
 /**
  * @brief Returns available random path
  *
  * @return AnnealingAlgorithm::Vector
  */
-AnnealingAlgorithm::Vector AnnealingAlgorithm::RandomPath() {
+AnnealingAlgorithm::Vector AnnealingAlgorithm::Chain::RandomPath() {
   Vector path;
   size_t vertex = 0;
   int choice = RandomChoice(graph_.size() - 1);
@@ -56,55 +465,164 @@ AnnealingAlgorithm::Vector AnnealingAlgorithm::RandomPath() {
  * @param max right border of range
  * @return int
  */
-int AnnealingAlgorithm::RandomChoice(int max) {
-  std::uniform_int_distribution<int> dist(0, max);
-  std::random_device rd;
-  return dist(rd);
+int AnnealingAlgorithm::Chain::RandomChoice(int max) {
+  return random_.NextInt(0, max);
 }
 
 /**
- * @brief Calculates distance at given TsmResult struct
+ * @brief Calculates distance of the closed tour, missing edges cost nothing
  *
- * @param tsm
+ * @param tour
  * @return double
  */
-double AnnealingAlgorithm::GetDistance(const TsmResult &tsm) {
+double AnnealingAlgorithm::Chain::GetDistance(const Vector &tour) {
   double distance = 0.0;
   for (size_t i = 1; i < graph_.size(); ++i) {
-    distance += graph_[tsm.vertices[i - 1]][tsm.vertices[i]];
+    distance += graph_[tour[i - 1]][tour[i]];
   }
-  distance += graph_[tsm.vertices[graph_.size() - 1]][tsm.vertices[0]];
+  distance += graph_[tour[graph_.size() - 1]][tour[0]];
   return distance;
 }
 
 /**
- * @brief Randomly shuffles vertices in TsmResult struct
+ * @brief Swaps two random vertices of the tour. Only the edges at the
+ * positions of the vertices change, so they are compared before and after
+ * the swap, which is undone if the move is rejected.
  *
- * @param tsm
- * @return TsmResult
+ * @param temperature
+ * @return true if the move is accepted
+ */
+bool AnnealingAlgorithm::Chain::TrySwap(double temperature) {
+  const int size = tour_.size();
+  int i = RandomChoice(size - 1), j = RandomChoice(size - 1);
+  if (i == j) return false;
+  int edges[] = {Position(i - 1), i, Position(j - 1), j};
+  std::sort(edges, edges + 4);
+  int *end = std::unique(edges, edges + 4);
+  auto cost = [this, &edges, end, size] {
+    long long sum = 0;
+    for (int *e = edges; e != end; ++e) {
+      sum += Weight(tour_[*e], tour_[(*e + 1) % size]);
+    }
+    return sum;
+  };
+  long long before = cost();
+  std::swap(tour_[i], tour_[j]);
+  long long delta = cost() - before;
+  if (MakeDecision(delta, temperature)) {
+    distance_ += delta;
+    return true;
+  }
+  std::swap(tour_[i], tour_[j]);
+  return false;
+}
+
+/**
+ * @brief Reverses a random path of the tour, replacing edges (a, b) and
+ * (c, d) with (a, c) and (b, d). The reversed path costs the same only on
+ * symmetric graphs.
+ *
+ * @param temperature
+ * @return true if the move is accepted
  */
-TsmResult AnnealingAlgorithm::Shuffle(TsmResult tsm) {
-  int idx1 = RandomChoice(graph_.size() - 1);
-  int idx2 = RandomChoice(graph_.size() - 1);
-  std::swap(tsm.vertices[idx1], tsm.vertices[idx2]);
-  return tsm;
+bool AnnealingAlgorithm::Chain::TryTwoOpt(double temperature) {
+  const int size = tour_.size();
+  int i = RandomChoice(size - 1), j = RandomChoice(size - 1);
+  if (i > j) std::swap(i, j);
+  if (j - i < 2 || (i == 0 && j == size - 1)) return false;
+  int a = tour_[i], b = tour_[i + 1], c = tour_[j], d = tour_[Position(j + 1)];
+  long long delta = static_cast<long long>(Weight(a, c)) + Weight(b, d) -
+                    Weight(a, b) - Weight(c, d);
+  if (!MakeDecision(delta, temperature)) return false;
+  Reverse(i + 1, j);
+  distance_ += delta;
+  return true;
 }
 
 /**
- * @brief Returns random bool depending on current temperature
+ * @brief Moves a random path of one to three vertices to another place of
+ * the tour keeping its direction, so the move suits directed graphs
  *
- * @param tsm
- * @param r_tsm
+ * @param temperature
+ * @return true if the move is accepted
+ */
+bool AnnealingAlgorithm::Chain::TryOrOpt(double temperature) {
+  const int size = tour_.size();
+  int length = 1 + RandomChoice(std::min(2, size - 3));
+  int i = RandomChoice(size - length), j = RandomChoice(size - 1);
+  int last = i + length - 1;
+  if ((j >= i && j <= last) || j == Position(i - 1)) return false;
+  int p = tour_[Position(i - 1)], q = tour_[Position(last + 1)];
+  int first_vertex = tour_[i], last_vertex = tour_[last];
+  int x = tour_[j], y = tour_[Position(j + 1)];
+  long long delta = static_cast<long long>(Weight(p, q)) +
+                    Weight(x, first_vertex) + Weight(last_vertex, y) -
+                    Weight(p, first_vertex) - Weight(last_vertex, q) -
+                    Weight(x, y);
+  if (!MakeDecision(delta, temperature)) return false;
+  if (j > last) {
+    std::rotate(tour_.begin() + i, tour_.begin() + last + 1,
+                tour_.begin() + j + 1);
+  } else {
+    std::rotate(tour_.begin() + j + 1, tour_.begin() + i,
+                tour_.begin() + last + 1);
+  }
+  distance_ += delta;
+  return true;
+}
+
+/**
+ * @brief Reverses positions [first, last] of the tour, or the rest of the
+ * cycle if it is shorter, which gives the same tour on symmetric graphs
+ *
+ * @param first
+ * @param last
+ */
+void AnnealingAlgorithm::Chain::Reverse(int first, int last) {
+  const int size = tour_.size();
+  int inner = last - first + 1;
+  if (inner > size - inner) {
+    first = last + 1;
+    last = first + size - inner - 1;
+  }
+  for (int i = first, j = last; i < j; ++i, --j) {
+    std::swap(tour_[Position(i)], tour_[Position(j)]);
+  }
+}
+
+int AnnealingAlgorithm::Chain::Weight(int from, int to) const {
+  return graph_[from][to];
+}
+
+/**
+ * @brief Returns position of the tour for an index wrapped around the cycle
+ *
+ * @param index
+ * @return int
+ */
+int AnnealingAlgorithm::Chain::Position(int index) const {
+  const int size = tour_.size();
+  return (index % size + size) % size;
+}
+
+/**
+ * @brief Returns random bool depending on current temperature: shorter tours
+ * are always accepted, longer ones with chance exp(-delta / temp)
+ *
+ * @param delta Change of the tour length
  * @param temp Temperature value
  * @return true
  * @return false
  */
-bool AnnealingAlgorithm::MakeDecision(const TsmResult &tsm,
-                                      const TsmResult &r_tsm, double temp) {
-  if ((tsm.distance > r_tsm.distance) or
-      (static_cast<int>(std::exp((tsm.distance - r_tsm.distance) / temp) *
-                        100) > RandomChoice(100)))
+bool AnnealingAlgorithm::Chain::MakeDecision(long long delta, double temp) {
+  if (delta > 0) {
+    ++counters_.uphill;
+    counters_.uphill_sum += delta;
+  }
+  if ((delta < 0) or
+      (static_cast<int>(std::exp(-delta / temp) * 100) > RandomChoice(100))) {
     return true;
+  }
   return false;
 }
 
@@ -1,10 +1,16 @@
 #ifndef SRC_LIB_ANNEALING_ALGORITHM_H
 #define SRC_LIB_ANNEALING_ALGORITHM_H
 
+#include <chrono>
+#include <memory>
 #include <random>
 #include <vector>
 
+#include "../misc/cancellation_token.h"
+#include "../misc/thread_pool.h"
 #include "heuristics.h"
+#include "local_search.h"
+#include "random.h"
 #include "s21_graph.h"
 #include "tsmresult.h"
 
@@ -13,21 +19,105 @@ class AnnealingAlgorithm {
   using Vector = std::vector<int>;
   using Matrix = std::vector<std::vector<int>>;
 
-  explicit AnnealingAlgorithm(const Graph &);
+  /**
+   * @brief Variants of the algorithm: one cooling chain, the best of
+   * independent cooling chains, and replicas at fixed temperatures exchanging
+   * their tours (parallel tempering)
+   *
+   */
+  enum class Mode { kSingle, kMultiStart, kTempering };
+
+  explicit AnnealingAlgorithm(const Graph &,
+                              uint64_t seed = Random::MakeSeed());
 
   void RunAlgorithm();
   TsmResult GetResult() const;
+  void SetMode(Mode mode);
+  void SetThreadsCount(size_t threads);
+  void SetReplicasCount(size_t replicas);
+  void SetTimeBudget(double seconds);
+  void SetAttemptsBudget(size_t attempts);
+  void SetLocalSearch(bool enabled);
+  void SetInitialTour(const Vector &tour);
+  void SetCancellationToken(const CancellationToken *token);
+  void SetProgressCallback(TsmCallback callback);
 
  private:
-  Vector RandomPath();
-  int RandomChoice(int max);
-  double GetDistance(const TsmResult &);
-  TsmResult Shuffle(TsmResult);
-  bool MakeDecision(const TsmResult &, const TsmResult &, double);
+  /**
+   * @brief Markov chain of the annealing: a tour, its length and a generator
+   * of its own, so chains may run in different threads
+   *
+   */
+  class Chain {
+   public:
+    /**
+     * @brief Statistics of the attempts of one run
+     *
+     */
+    struct Counters {
+      int uphill = 0;
+      double uphill_sum = 0.0;
+    };
+
+    Chain(const AnnealingAlgorithm &, uint64_t seed);
+
+    Counters Run(double temperature, int attempts);
+    double GetDistance() const;
+    const Vector &GetTour() const;
+    void Exchange(Chain *other);
+
+   private:
+    Vector RandomPath();
+    int RandomChoice(int max);
+    double GetDistance(const Vector &);
+    bool TrySwap(double);
+    bool TryTwoOpt(double);
+    bool TryOrOpt(double);
+    void Reverse(int first, int last);
+    int Weight(int from, int to) const;
+    int Position(int index) const;
+    bool MakeDecision(long long delta, double);
+
+    const Matrix &graph_;
+    bool symmetric_;
+    Random random_;
+    Vector tour_;
+    long long distance_ = 0;
+    Counters counters_;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  void RunSingle();
+  void RunMultiStart();
+  void RunTempering();
+  TsmResult Cool(Chain *chain, double seconds) const;
+  TsmResult CoolWithin(Chain *chain, double seconds) const;
+  bool HasBudget() const;
+  double GetProgress(Clock::time_point start, size_t attempts,
+                     double seconds) const;
+  void ForEach(size_t count, const std::function<void(size_t)> &body);
+  bool IsCancelled() const;
+  void Report(const Vector &tour) const;
 
   const Matrix &graph_;
+  const Graph &source_;
   const Heuristics consts_;
   TsmResult result_;
+  uint64_t seed_;
+  uint64_t run_seed_ = 0;
+  size_t runs_ = 0;
+  bool symmetric_;
+  Mode mode_ = Mode::kSingle;
+  size_t threads_ = ThreadPool::DefaultThreadsCount();
+  size_t replicas_;
+  double time_budget_ = 0.0;
+  size_t attempts_budget_ = 0;
+  bool polish_ = false;
+  Vector initial_;
+  const CancellationToken *token_ = nullptr;
+  TsmCallback callback_;
+  std::unique_ptr<ThreadPool> pool_;
 };
 
 #endif  // SRC_LIB_ANNEALING_ALGORITHM_H
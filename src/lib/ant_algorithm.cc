@@ -1,214 +1,693 @@
 #include "ant_algorithm.h"
 
+#include "tour_construction.h"
+
 /**
- * @brief Construct a new Ant:: Ant object
+ * @brief Construct a new Ant:: Ant object. Every ant has its own generator,
+ * so ants may run in different threads.
  *
  * @param graph
+ * @param neighbours Candidate lists of the colony
  * @param start
+ * @param seed Seed of the generator of the ant
  */
-Ant::Ant(const Graph &graph, size_t start)
-    : graph_{graph}, tabu_{Tabu(graph.GetGraph().size())} {
-  path_.push_back(start);
-  tabu_[start] = true;
+Ant::Ant(const Graph &graph, const NeighbourLists &neighbours, size_t start,
+         uint64_t seed)
+    : graph_{graph},
+      neighbours_{neighbours},
+      start_{start},
+      random_{seed},
+      tabu_{Tabu(graph.GetGraph().size())},
+      cumulate_(graph.GetGraph().size() + 1) {
+  path_.reserve(graph.GetGraph().size() + 1);
+  Reset();
+}
+
+/**
+ * @brief Returns the ant to its starting vertex, keeping the buffers
+ *
+ */
+void Ant::Reset() {
+  path_.assign(1, start_);
+  std::fill(tabu_.begin(), tabu_.end(), false);
+  tabu_[start_] = true;
+  distance_ = 0.0;
 }
 
 /**
  * @brief Simulates one pass of the graph by an ant
  *
- * @param Pheromones
+ * @param attractiveness
  */
-void Ant::MakeBypass(const Pheromones &pheromones) {
+void Ant::MakeBypass(const Attractiveness &attractiveness) {
+  Reset();
   for (size_t i = 0; i < graph_.GetGraph().size(); ++i) {
-    int next = ChooseNextPath(pheromones, path_.back());
+    int next = ChooseNextPath(attractiveness, path_.back());
     if (next != -1) {
-      visited_.push_back(std::make_pair(path_.back(), next));
       path_.push_back(next);
       tabu_[next] = true;
     }
   }
   path_.push_back(path_.front());
+  distance_ = 0.0;
+  for (size_t i = 0; i < path_.size() - 1; ++i) {
+    distance_ += graph_.GetGraph()[path_[i]][path_[i + 1]];
+  }
 }
 
 /**
- * @brief Randomly choses next available vertex
+ * @brief Randomly choses next available vertex with probabilities
+ * proportional to attractiveness of the paths. Only the nearest neighbours
+ * of the vertex are candidates, all the vertices are tried when every
+ * neighbour is visited, so a step takes O(k) on most of the tour. With the
+ * probability of greediness the most attractive path is taken instead.
  *
- * @param Pheromones
+ * @param attractiveness
  * @param path
  * @return int
  */
-int Ant::ChooseNextPath(const Pheromones &pheromones, size_t path) {
-  Chances chances = GetChances(pheromones, path);
-  double rnd = RandomChoice(0.0, 1.0);
-  for (size_t i = 1; i < chances.size(); ++i) {
-    if (!tabu_[i - 1] and rnd < chances[i]) return i - 1;
+int Ant::ChooseNextPath(const Attractiveness &attractiveness, size_t path) {
+  const std::vector<double> &row = attractiveness[path];
+  if (greediness_ > 0.0 && RandomChoice(0.0, 1.0) < greediness_) {
+    return ChooseBest(row, path);
+  }
+  const NeighbourLists::List &candidates = neighbours_[path];
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    int v = candidates[i];
+    cumulate_[i + 1] = cumulate_[i] + (tabu_[v] ? 0.0 : row[v]);
+  }
+  int next = ChooseCumulate(candidates.size());
+  if (next != -1) return candidates[next];
+  for (size_t i = 0; i < row.size(); ++i) {
+    cumulate_[i + 1] = cumulate_[i] + (tabu_[i] ? 0.0 : row[i]);
   }
-  return -1;
+  return ChooseCumulate(row.size());
 }
 
 /**
- * @brief Returns probabilities of paths transition depending on pheromones
- * values
+ * @brief Returns random index in [0, count) with probabilities proportional
+ * to the weights, whose cumulative sums are in the reused buffer, -1 if all
+ * the weights are zeros. The sums are searched by bisection.
  *
- * @param Pheromones
+ * @param count
+ * @return int
+ */
+int Ant::ChooseCumulate(size_t count) {
+  if (cumulate_[count] <= 0.0) return -1;
+  double rnd = RandomChoice(0.0, 1.0) * cumulate_[count];
+  auto end = cumulate_.begin() + count + 1;
+  auto it = std::upper_bound(cumulate_.begin() + 1, end, rnd);
+  if (it == end) return -1;
+  return it - cumulate_.begin() - 1;
+}
+
+/**
+ * @brief Returns the unvisited vertex with the most attractive path, looking
+ * at the nearest neighbours first, -1 if there is no such vertex
+ *
+ * @param row Attractiveness of the paths from the vertex
  * @param path
- * @return Ant::Chances
- */
-Ant::Chances Ant::GetChances(const Pheromones &pheromones, size_t path) {
-  Chances chances = Chances(graph_.GetGraph().size());
-  double total = 0.0;
-  for (size_t i = 0; i < chances.size(); ++i) {
-    if (graph_.GetGraph()[path][i] and !tabu_[i]) {
-      chances[i] = std::pow(pheromones[path][i], consts_.kAlpha) *
-                   std::pow(1.0 / graph_.GetGraph()[path][i], consts_.kBeta);
-      total += chances[i];
-    } else {
-      chances[i] = INFINITY;
+ * @return int
+ */
+int Ant::ChooseBest(const std::vector<double> &row, size_t path) {
+  int best = -1;
+  for (int v : neighbours_[path]) {
+    if (!tabu_[v] && row[v] > 0.0 && (best == -1 || row[v] > row[best])) {
+      best = v;
     }
   }
-  for (size_t i = 0; i < chances.size(); ++i) {
-    chances[i] = !std::isinf(chances[i]) ? chances[i] / total : 0;
-  }
-  Chances cumulate(chances.size() + 1);
-  for (size_t i = 0; i < chances.size(); ++i) {
-    cumulate[i + 1] = cumulate[i] + chances[i];
+  if (best != -1) return best;
+  for (size_t v = 0; v < row.size(); ++v) {
+    if (!tabu_[v] && row[v] > 0.0 && (best == -1 || row[v] > row[best])) {
+      best = v;
+    }
   }
-  return cumulate;
+  return best;
 }
 
 /**
- * @brief Returns random double number from range [min, max]
+ * @brief Returns random double number from range [min, max)
  *
  * @param min left border of range
  * @param max right border of range
  * @return double
  */
 double Ant::RandomChoice(const double min, const double max) {
-  std::uniform_real_distribution<double> dist(min, max);
-  std::random_device rd;
-  return dist(rd);
+  return random_.NextDouble(min, max);
 }
 
 /**
- * @brief Calculates distance of path member
+ * @brief Returns distance of path member calculated at the end of the bypass
  *
  * @return double
  */
-double Ant::GetDistance() const {
-  double distance = 0.0;
-  for (size_t i = 0; i < path_.size() - 1; ++i) {
-    distance += graph_.GetWeight(path_[i], path_[i + 1]);
-  }
-  return distance;
-}
+double Ant::GetDistance() const { return distance_; }
 
 /**
  * @brief Returns path member
  *
- * @return Ant::Path
+ * @return const Ant::Path&
  */
-Ant::Path Ant::GetPath() const { return path_; }
+const Ant::Path &Ant::GetPath() const { return path_; }
 
 /**
- * @brief Returns true if vertex with (i, j) coordinates in visited member,
- * otherwise - false
+ * @brief Sets probability of taking the most attractive path instead of a
+ * random one, q0 of Ant Colony System
  *
- * @param i
- * @param j
- * @return true
- * @return false
+ * @param greediness
  */
-bool Ant::IsVisited(size_t i, size_t j) {
-  if (std::any_of(visited_.begin(), visited_.end(),
-                  [&i, &j](std::pair<size_t, size_t> v) {
-                    return v.first == i and v.second == j;
-                  }))
-    return true;
-  return false;
-}
+void Ant::SetGreediness(double greediness) { greediness_ = greediness; }
 
 /**
- * @brief Construct a new Ant Algorithm:: Ant Algorithm object
+ * @brief Construct a new Ant Algorithm:: Ant Algorithm object. Visibility of
+ * the paths does not depend on pheromones, so it is calculated once, as well
+ * as the length of a random tour used to scale pheromone deposits.
  *
  * @param graph
+ * @param seed Seed of the random generator, islands and ants get independent
+ * streams
  */
-AntAlgorithm::AntAlgorithm(const Graph &graph) : graph_{graph} {}
+AntAlgorithm::AntAlgorithm(const Graph &graph, uint64_t seed)
+    : graph_{graph},
+      seed_{seed},
+      neighbours_{graph, consts_.kNeighbours},
+      local_search_{graph},
+      directed_{graph.IsDirected()},
+      iterations_{consts_.kColonies * consts_.kBypassCount},
+      migration_{consts_.kMigration} {
+  const Graph::Matrix &m = graph_.GetGraph();
+  visibility_ = Attractiveness(m.size(), std::vector<double>(m.size()));
+  double weights = 0.0, edges = 0.0;
+  for (size_t i = 0; i < m.size(); ++i) {
+    for (size_t j = 0; j < m.size(); ++j) {
+      if (m[i][j]) {
+        visibility_[i][j] = std::pow(1.0 / m[i][j], consts_.kBeta);
+        weights += m[i][j];
+        ++edges;
+      }
+    }
+  }
+  if (edges > 0) tour_scale_ = weights / edges * m.size();
+}
 
 /**
- * @brief Runs Ant Algotithm on loaded graph
+ * @brief Runs Ant Algotithm on loaded graph. The iterations are split between
+ * islands, colonies running concurrently in epochs of the migration interval,
+ * and the best tours migrate after every epoch. Ant System restarts the
+ * colony of an island every kBypassCount iterations, the other modes run one
+ * colony per island. Every colony starts with the best tour of its island,
+ * the first one with the initial tour if there is one. With one island the
+ * pool runs the ants instead. A cancelled run stops after the current
+ * iteration with the best tour found. Every run takes a new stream of the
+ * seed, so repeated runs give different tours. A shorter tour of the source
+ * joins the colony as a migrant after every iteration.
  *
  */
 void AntAlgorithm::RunAlgorithm() {
-  TsmResult result{Path{}, INFINITY};
-  for (size_t i = 0; i < consts_.kColonies; ++i) {
-    RunColony();
-    TsmResult cur = result_;
-    if (cur.distance < result.distance) {
-      result = std::move(cur);
+  const size_t size = graph_.GetGraph().size();
+  const size_t islands = std::max<size_t>(1, islands_);
+  size_t threads = std::min(threads_, islands > 1 ? islands : size);
+  std::unique_ptr<ThreadPool> pool;
+  if (threads > 1) pool = std::make_unique<ThreadPool>(threads);
+  const uint64_t seed = Random::DeriveRun(seed_, runs_++);
+  std::vector<Colony> colonies;
+  colonies.reserve(islands);
+  for (size_t i = 0; i < islands; ++i) {
+    if (islands > 1) {
+      colonies.emplace_back(*this, Random::Derive(seed, i), nullptr, 1);
+    } else {
+      colonies.emplace_back(*this, Random::Derive(seed, i), pool.get(),
+                            std::max<size_t>(1, threads));
+    }
+  }
+  const size_t iterations = std::max<size_t>(1, iterations_ / islands);
+  const size_t epoch = migration_ ? migration_ : iterations;
+  for (size_t done = 0; done < iterations; done += epoch) {
+    size_t last = std::min(done + epoch, iterations);
+    auto run = [this, &colonies, done, last](size_t island) {
+      for (size_t i = done; i < last && !IsCancelled(); ++i) {
+        if (mode_ == Mode::kAntSystem ? i % consts_.kBypassCount == 0
+                                      : i == 0) {
+          colonies[island].Start();
+          if (i == 0 && !initial_.vertices.empty()) {
+            colonies[island].Accept(initial_);
+          }
+        }
+        colonies[island].Step();
+        Import(&colonies[island]);
+      }
+    };
+    if (pool && islands > 1) {
+      pool->ParallelFor(islands, [&run](size_t island, size_t) {
+        run(island);
+      });
+    } else {
+      for (size_t island = 0; island < islands; ++island) run(island);
+    }
+    if (IsCancelled()) break;
+    if (last < iterations) Migrate(&colonies);
+  }
+  result_ = TsmResult{Path{}, INFINITY};
+  for (const Colony &colony : colonies) {
+    if (colony.GetBest().distance < result_.distance) {
+      result_ = colony.GetBest();
     }
   }
-  result_ = result;
 }
 
 /**
- * @brief Simulates pass of the graph by colony of ants
+ * @brief Sets number of threads running the islands, or the ants if there is
+ * one island, one by default, 0 - number of hardware threads. Ants are split
+ * between threads in fixed blocks, so equal seeds and equal numbers of
+ * threads give equal results.
  *
+ * @param threads
  */
-void AntAlgorithm::RunColony() {
-  result_ = TsmResult{Path{}, INFINITY};
-  pheromones_ =
-      Pheromones(graph_.GetGraph().size(),
-                 std::vector<double>(graph_.GetGraph().size(), consts_.kTau));
-  for (size_t i = 0; i < consts_.kBypassCount; ++i) {
-    RunAnts();
-    UpdateResult();
-    UpdatePheromones();
-  };
+void AntAlgorithm::SetThreadsCount(size_t threads) {
+  threads_ = threads ? threads : ThreadPool::DefaultThreadsCount();
 }
 
 /**
- * @brief Simulates pass of the graph by ants of colony
+ * @brief Sets number of the nearest neighbours an ant chooses from, k.
+ * Larger k gives the pheromones more choice and slows the steps down, 0 makes
+ * every vertex a candidate.
  *
+ * @param count
  */
-void AntAlgorithm::RunAnts() {
-  ants_ = Ants(graph_.GetGraph().size());
-  for (size_t i = 0; i < graph_.GetGraph().size(); ++i) {
-    ants_[i] = std::make_unique<Ant>(graph_, i);
+void AntAlgorithm::SetNeighboursCount(size_t count) {
+  neighbours_ = NeighbourLists(graph_, count);
+}
+
+/**
+ * @brief Sets variant of the colony
+ *
+ * @param mode
+ */
+void AntAlgorithm::SetMode(Mode mode) { mode_ = mode; }
+
+/**
+ * @brief Enables 2-opt and Or-opt improvement of the best tour of every
+ * iteration
+ *
+ * @param enabled
+ */
+void AntAlgorithm::SetLocalSearch(bool enabled) { polish_ = enabled; }
+
+/**
+ * @brief Sets number of iterations of all the colonies, kColonies *
+ * kBypassCount by default
+ *
+ * @param iterations
+ */
+void AntAlgorithm::SetIterationsCount(size_t iterations) {
+  iterations_ = iterations;
+}
+
+/**
+ * @brief Sets number of islands sharing the iterations, one by default, 0 -
+ * number of hardware threads. Islands do not depend on the number of threads,
+ * so equal seeds and equal numbers of islands give equal results.
+ *
+ * @param islands
+ */
+void AntAlgorithm::SetIslandsCount(size_t islands) {
+  islands_ = islands ? islands : ThreadPool::DefaultThreadsCount();
+}
+
+/**
+ * @brief Sets number of iterations between migrations of the best tours,
+ * kMigration by default, 0 - islands never exchange tours
+ *
+ * @param iterations
+ */
+void AntAlgorithm::SetMigrationInterval(size_t iterations) {
+  migration_ = iterations;
+}
+
+/**
+ * @brief Sets the tour every colony deposits pheromones on as its best one
+ * when it starts, an empty tour or one with missing edges is not deposited
+ *
+ * @param tour Zero-based permutation of the vertices
+ */
+void AntAlgorithm::SetInitialTour(const Path &tour) {
+  const size_t size = graph_.GetGraph().size();
+  if (!tour.empty() && !TourConstruction::IsTour(tour, size)) {
+    throw std::logic_error("The initial tour is not a permutation of vertices");
   }
-  for (const auto &ant : ants_) {
-    ant->MakeBypass(pheromones_);
+  initial_ = TsmResult();
+  double distance = TourConstruction(graph_).GetLength(tour);
+  if (tour.empty() || distance == INFINITY) return;
+  initial_ = TsmResult{tour, distance};
+  initial_.vertices.push_back(tour.front());
+}
+
+/**
+ * @brief Sets the token stopping the run, nullptr - the run is not stopped
+ *
+ * @param token Token outliving the run
+ */
+void AntAlgorithm::SetCancellationToken(const CancellationToken *token) {
+  token_ = token;
+}
+
+/**
+ * @brief Sets the callback getting every new best tour of a colony, colonies
+ * of different islands may call it concurrently
+ *
+ * @param callback
+ */
+void AntAlgorithm::SetProgressCallback(TsmCallback callback) {
+  callback_ = std::move(callback);
+}
+
+/**
+ * @brief Sets the source of shorter tours joining the colonies as migrants,
+ * nullptr - the tours are not shared. Colonies of different islands may call
+ * it concurrently.
+ *
+ * @param source
+ */
+void AntAlgorithm::SetTourSource(TsmSource source) {
+  tour_source_ = std::move(source);
+}
+
+/**
+ * @brief Sends the best tour of every island to the next island of the ring
+ *
+ * @param colonies
+ */
+void AntAlgorithm::Migrate(std::vector<Colony> *colonies) {
+  if (colonies->size() < 2) return;
+  std::vector<TsmResult> migrants;
+  for (const Colony &colony : *colonies) migrants.push_back(colony.GetBest());
+  for (size_t i = 0; i < migrants.size(); ++i) {
+    (*colonies)[(i + 1) % migrants.size()].Accept(migrants[i]);
   }
 }
 
 /**
- * @brief Updates pheromones member values
+ * @brief Construct a new Ant Algorithm:: Colony:: Colony object. The ants are
+ * built once and reused by all the iterations.
  *
+ * @param algo Algorithm sharing the graph data
+ * @param seed Seed of the island
+ * @param pool Pool running the ants, nullptr - ants run in the caller
+ * @param blocks Number of blocks of ants
  */
-void AntAlgorithm::UpdatePheromones() {
-  for (size_t i = 0; i < graph_.GetGraph().size(); ++i) {
-    for (size_t j = 0; j < graph_.GetGraph().size(); ++j) {
-      for (size_t k = 0; k < ants_.size(); ++k) {
-        if (ants_[k]->IsVisited(i, j)) {
-          pheromones_[i][j] += (1 - consts_.kRo) * pheromones_[i][j] +
-                               consts_.kQ / ants_[k]->GetDistance();
-          pheromones_[j][i] = pheromones_[i][j];
-        }
+AntAlgorithm::Colony::Colony(const AntAlgorithm &algo, uint64_t seed,
+                             ThreadPool *pool, size_t blocks)
+    : algo_{algo},
+      consts_{algo.consts_},
+      pool_{pool},
+      blocks_{blocks},
+      best_{Path{}, INFINITY} {
+  const size_t size = algo_.graph_.GetGraph().size();
+  double greediness =
+      algo_.mode_ == Mode::kColonySystem ? consts_.kGreediness : 0.0;
+  ants_.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    ants_.emplace_back(algo_.graph_, algo_.neighbours_, i,
+                       Random::Derive(seed, i));
+    ants_.back().SetGreediness(greediness);
+  }
+  if (algo_.mode_ == Mode::kAntSystem) {
+    deltas_.assign(blocks_, Pheromones(size, std::vector<double>(size)));
+  }
+  attractiveness_.assign(size, std::vector<double>(size));
+}
+
+/**
+ * @brief Starts the colony from scratch. Pheromones start at kTau in Ant
+ * System, at the upper bound for a random tour in MAX-MIN Ant System and at
+ * tau0 = Q / n in Ant Colony System. The best tour of the island, which may
+ * be a migrant or the initial tour, is deposited on them again, so it
+ * survives the restarts of Ant System.
+ *
+ */
+void AntAlgorithm::Colony::Start() {
+  result_ = TsmResult{Path{}, INFINITY};
+  stagnation_ = 0;
+  if (algo_.mode_ == Mode::kAntSystem) {
+    ResetPheromones(consts_.kTau);
+  } else if (algo_.mode_ == Mode::kMaxMin) {
+    ResetPheromones(consts_.kQ / consts_.kMaxMinRo);
+  } else {
+    ResetPheromones(consts_.kQ / ants_.size());
+  }
+  if (!best_.vertices.empty()) Accept(TsmResult(best_));
+}
+
+/**
+ * @brief Simulates one pass of the graph by the colony
+ *
+ */
+void AntAlgorithm::Colony::Step() {
+  RunAnts();
+  UpdateResult();
+  UpdatePheromones();
+}
+
+/**
+ * @brief Takes the tour of another island if it is better than the tour of
+ * the colony and deposits pheromones on it as on the best tour
+ *
+ * @param migrant
+ */
+void AntAlgorithm::Colony::Accept(const TsmResult &migrant) {
+  if (migrant.distance < best_.distance) best_ = migrant;
+  if (migrant.distance <= 0.0 || migrant.distance >= result_.distance) return;
+  result_ = migrant;
+  stagnation_ = 0;
+  double deposit = consts_.kQ * algo_.tour_scale_ / migrant.distance;
+  bool acs = algo_.mode_ == Mode::kColonySystem;
+  const Path &path = migrant.vertices;
+  for (size_t i = 1; i < path.size(); ++i) {
+    if (acs) {
+      UpdateEdge(path[i - 1], path[i], 1 - consts_.kColonyRo,
+                 consts_.kColonyRo * deposit);
+    } else {
+      UpdateEdge(path[i - 1], path[i], 1.0, deposit);
+    }
+  }
+}
+
+/**
+ * @brief Returns the best tour of the island over all its colonies
+ *
+ * @return const TsmResult&
+ */
+const TsmResult &AntAlgorithm::Colony::GetBest() const { return best_; }
+
+/**
+ * @brief Simulates pass of the graph by ants of colony. The ants only read
+ * the attractiveness, so every thread runs its own block of ants and then
+ * collects their pheromones in its own buffer. In Ant Colony System every ant
+ * moves the pheromones of its tour towards tau0 for the next ants, so the
+ * ants run one after another.
+ *
+ */
+void AntAlgorithm::Colony::RunAnts() {
+  if (algo_.mode_ == Mode::kColonySystem) {
+    double pheromone = consts_.kQ / ants_.size();
+    for (Ant &ant : ants_) {
+      ant.MakeBypass(attractiveness_);
+      const Path &path = ant.GetPath();
+      for (size_t i = 1; i < path.size(); ++i) {
+        UpdateEdge(path[i - 1], path[i], 1 - consts_.kColonyXi,
+                   consts_.kColonyXi * pheromone);
       }
     }
+    return;
+  }
+  ForEach(blocks_, [this](size_t block) {
+    size_t first = ants_.size() * block / blocks_;
+    size_t last = ants_.size() * (block + 1) / blocks_;
+    for (size_t i = first; i < last; ++i) ants_[i].MakeBypass(attractiveness_);
+    if (algo_.mode_ == Mode::kAntSystem) DepositPheromones(block);
+  });
+}
+
+/**
+ * @brief Adds Q / L to the buffer of the block on the paths of the tours of
+ * its ants, where L is the tour length relative to a random tour, so deposits
+ * do not depend on the scale of weights
+ *
+ * @param block
+ */
+void AntAlgorithm::Colony::DepositPheromones(size_t block) {
+  Pheromones &delta = deltas_[block];
+  size_t first = ants_.size() * block / blocks_;
+  size_t last = ants_.size() * (block + 1) / blocks_;
+  for (size_t a = first; a < last; ++a) {
+    const Ant &ant = ants_[a];
+    if (ant.GetDistance() <= 0.0) continue;
+    const Path &path = ant.GetPath();
+    double deposit = consts_.kQ * algo_.tour_scale_ / ant.GetDistance();
+    for (size_t i = 1; i < path.size(); ++i) {
+      delta[path[i - 1]][path[i]] += deposit;
+      if (!algo_.directed_) delta[path[i]][path[i - 1]] += deposit;
+    }
   }
 }
 
 /**
- * @brief Updates member result with least distance
+ * @brief Sets every pheromone to the value
+ *
+ * @param pheromone
+ */
+void AntAlgorithm::Colony::ResetPheromones(double pheromone) {
+  const size_t size = ants_.size();
+  pheromones_.assign(size, std::vector<double>(size, pheromone));
+  ForEach(size, [this](size_t i) { UpdateAttractiveness(i); });
+}
+
+/**
+ * @brief Updates pheromones member values. Ant System evaporates every path,
+ * tau = (1 - ro) * tau, and adds the buffers of the blocks in their order.
+ * Rows are reduced in parallel and refresh their attractiveness right away.
+ * In O(n^2 * blocks). Ant Colony System moves only the paths of the best
+ * tour towards its deposit, in O(n).
  *
  */
-void AntAlgorithm::UpdateResult() {
-  std::sort(ants_.begin(), ants_.end(), [](auto &x, auto &y) {
-    return x->GetDistance() < y->GetDistance();
+void AntAlgorithm::Colony::UpdatePheromones() {
+  if (algo_.mode_ == Mode::kMaxMin) {
+    UpdateMaxMin();
+    return;
+  }
+  if (algo_.mode_ == Mode::kColonySystem) {
+    if (result_.distance <= 0.0) return;
+    const Path &path = result_.vertices;
+    double deposit = consts_.kQ * algo_.tour_scale_ / result_.distance;
+    for (size_t i = 1; i < path.size(); ++i) {
+      UpdateEdge(path[i - 1], path[i], 1 - consts_.kColonyRo,
+                 consts_.kColonyRo * deposit);
+    }
+    return;
+  }
+  ForEach(pheromones_.size(), [this](size_t i) {
+    std::vector<double> &row = pheromones_[i];
+    for (double &pheromone : row) pheromone *= 1 - consts_.kRo;
+    for (Pheromones &delta : deltas_) {
+      for (size_t j = 0; j < row.size(); ++j) {
+        row[j] += delta[i][j];
+        delta[i][j] = 0.0;
+      }
+    }
+    UpdateAttractiveness(i);
   });
-  const auto &path = ants_.front();
-  TsmResult result = TsmResult{path->GetPath(), path->GetDistance()};
-  if (result.distance < result_.distance) {
-    result_ = std::move(result);
+}
+
+/**
+ * @brief Updates pheromones of MAX-MIN Ant System: every path evaporates,
+ * only the best tour of the iteration deposits, and the pheromones are kept
+ * in [tau_max / 2n, tau_max], where tau_max = Q / (ro * L) for the best
+ * tour L. After kStagnation iterations without a better tour all the
+ * pheromones return to tau_max.
+ *
+ */
+void AntAlgorithm::Colony::UpdateMaxMin() {
+  const size_t size = pheromones_.size();
+  if (result_.distance <= 0.0 || iteration_.distance <= 0.0) return;
+  double max =
+      consts_.kQ * algo_.tour_scale_ / (consts_.kMaxMinRo * result_.distance);
+  double min = max / (2.0 * size);
+  if (stagnation_ >= consts_.kStagnation) {
+    stagnation_ = 0;
+    ResetPheromones(max);
+    return;
+  }
+  ForEach(size, [this](size_t i) {
+    for (double &pheromone : pheromones_[i]) {
+      pheromone *= 1 - consts_.kMaxMinRo;
+    }
+  });
+  const Path &path = iteration_.vertices;
+  double deposit = consts_.kQ * algo_.tour_scale_ / iteration_.distance;
+  for (size_t i = 1; i < path.size(); ++i) {
+    pheromones_[path[i - 1]][path[i]] += deposit;
+    if (!algo_.directed_) pheromones_[path[i]][path[i - 1]] += deposit;
+  }
+  ForEach(size, [this, min, max](size_t i) {
+    for (double &pheromone : pheromones_[i]) {
+      pheromone = std::min(max, std::max(min, pheromone));
+    }
+    UpdateAttractiveness(i);
+  });
+}
+
+/**
+ * @brief Updates pheromone of the path, tau = keep * tau + add, and its
+ * attractiveness
+ *
+ * @param from
+ * @param to
+ * @param keep
+ * @param add
+ */
+void AntAlgorithm::Colony::UpdateEdge(int from, int to, double keep,
+                                      double add) {
+  double &tau = pheromones_[from][to];
+  tau = keep * tau + add;
+  attractiveness_[from][to] =
+      std::pow(tau, consts_.kAlpha) * algo_.visibility_[from][to];
+  if (!algo_.directed_) {
+    pheromones_[to][from] = tau;
+    attractiveness_[to][from] = attractiveness_[from][to];
+  }
+}
+
+/**
+ * @brief Updates attractiveness of the paths of the row, the product of
+ * pheromones and visibility raised to their powers
+ *
+ * @param row
+ */
+void AntAlgorithm::Colony::UpdateAttractiveness(size_t row) {
+  for (size_t j = 0; j < pheromones_.size(); ++j) {
+    attractiveness_[row][j] = std::pow(pheromones_[row][j], consts_.kAlpha) *
+                              algo_.visibility_[row][j];
+  }
+}
+
+/**
+ * @brief Updates the best tour of the iteration, polished by 2-opt and
+ * Or-opt if local
+ * search is enabled, and the best tours of the colony and of the island
+ *
+ */
+void AntAlgorithm::Colony::UpdateResult() {
+  auto best = std::min_element(
+      ants_.begin(), ants_.end(), [](const Ant &x, const Ant &y) {
+        return x.GetDistance() < y.GetDistance();
+      });
+  if (best == ants_.end()) return;
+  iteration_ = TsmResult{best->GetPath(), best->GetDistance()};
+  if (algo_.polish_) algo_.local_search_.Polish(&iteration_);
+  if (iteration_.distance < result_.distance) {
+    result_ = iteration_;
+    stagnation_ = 0;
+  } else {
+    ++stagnation_;
+  }
+  if (result_.distance < best_.distance) {
+    best_ = result_;
+    algo_.Report(best_);
+  }
+}
+
+/**
+ * @brief Calls body for every index in [0, count), on the pool if there is one
+ *
+ * @param count
+ * @param body
+ */
+void AntAlgorithm::Colony::ForEach(size_t count,
+                                   const std::function<void(size_t)> &body) {
+  if (pool_) {
+    pool_->ParallelFor(count, [&body](size_t i, size_t) { body(i); });
+  } else {
+    for (size_t i = 0; i < count; ++i) body(i);
   }
 }
 
@@ -244,3 +723,47 @@ bool AntAlgorithm::CheckResult() {
   }
   return true;
 }
+
+/**
+ * @brief Returns true if the token of the run is cancelled
+ *
+ * @return true
+ * @return false
+ */
+bool AntAlgorithm::IsCancelled() const {
+  return token_ && token_->IsCancelled();
+}
+
+/**
+ * @brief Passes the closed tour to the callback as a cyclic one if it visits
+ * all the vertices by existing edges
+ *
+ * @param result
+ */
+void AntAlgorithm::Report(const TsmResult &result) const {
+  const size_t size = graph_.GetGraph().size();
+  if (!callback_ || result.vertices.size() != size + 1) return;
+  Path tour(result.vertices.begin(), result.vertices.end() - 1);
+  double length = TourConstruction::GetLength(graph_, tour);
+  if (TourConstruction::IsTour(tour, size) && length != INFINITY) {
+    callback_(TsmResult{tour, length});
+  }
+}
+
+/**
+ * @brief Passes the tour of the source to the colony if it is shorter than
+ * the best tour of the colony
+ *
+ * @param colony
+ */
+void AntAlgorithm::Import(Colony *colony) const {
+  TsmResult shared;
+  const double distance = colony->GetBest().distance;
+  if (!tour_source_ || !tour_source_(distance, &shared)) return;
+  const size_t size = graph_.GetGraph().size();
+  if (!TourConstruction::IsTour(shared.vertices, size)) return;
+  shared.distance = TourConstruction(graph_).GetLength(shared.vertices);
+  if (shared.distance >= distance) return;
+  shared.vertices.push_back(shared.vertices.front());
+  colony->Accept(shared);
+}
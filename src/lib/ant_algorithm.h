@@ -7,7 +7,12 @@
 #include <string>
 #include <vector>
 
+#include "../misc/cancellation_token.h"
+#include "../misc/thread_pool.h"
 #include "heuristics.h"
+#include "local_search.h"
+#include "neighbour_lists.h"
+#include "random.h"
 #include "s21_graph.h"
 #include "tsmresult.h"
 
@@ -15,56 +20,134 @@ class Ant {
  public:
   using Path = std::vector<int>;
   using Tabu = std::vector<bool>;
-  using Visited = std::vector<std::pair<size_t, size_t>>;
-  using Pheromones = std::vector<std::vector<double>>;
+  using Attractiveness = std::vector<std::vector<double>>;
   using Chances = std::vector<double>;
 
-  Ant(const Graph &, size_t);
+  Ant(const Graph &, const NeighbourLists &, size_t, uint64_t);
 
-  void MakeBypass(const Pheromones &);
+  void Reset();
+  void MakeBypass(const Attractiveness &);
   double GetDistance() const;
-  Path GetPath() const;
-  bool IsVisited(size_t, size_t);
+  const Path &GetPath() const;
+  void SetGreediness(double greediness);
 
  private:
-  int ChooseNextPath(const Pheromones &, size_t);
-  Chances GetChances(const Pheromones &, size_t);
+  int ChooseNextPath(const Attractiveness &, size_t);
+  int ChooseCumulate(size_t);
+  int ChooseBest(const std::vector<double> &, size_t);
   double RandomChoice(const double, const double);
 
  private:
   const Graph &graph_;
+  const NeighbourLists &neighbours_;
+  size_t start_;
+  Random random_;
   Tabu tabu_;
   Path path_;
-  Visited visited_;
-  Heuristics consts_;
+  Chances cumulate_;
+  double distance_ = 0.0;
+  double greediness_ = 0.0;
 };
 
 class AntAlgorithm {
  public:
   using Path = std::vector<int>;
-  using Ants = std::vector<std::unique_ptr<Ant>>;
+  using Ants = std::vector<Ant>;
   using Pheromones = std::vector<std::vector<double>>;
-  using Chances = std::vector<double>;
+  using Attractiveness = std::vector<std::vector<double>>;
+
+  /**
+   * @brief Variants of the colony: Ant System, MAX-MIN Ant System and Ant
+   * Colony System
+   *
+   */
+  enum class Mode { kAntSystem, kMaxMin, kColonySystem };
 
  public:
-  explicit AntAlgorithm(const Graph &);
+  explicit AntAlgorithm(const Graph &, uint64_t seed = Random::MakeSeed());
 
   void RunAlgorithm();
   TsmResult GetResult();
+  void SetThreadsCount(size_t threads);
+  void SetNeighboursCount(size_t count);
+  void SetMode(Mode mode);
+  void SetLocalSearch(bool enabled);
+  void SetIterationsCount(size_t iterations);
+  void SetIslandsCount(size_t islands);
+  void SetMigrationInterval(size_t iterations);
+  void SetInitialTour(const Path &tour);
+  void SetCancellationToken(const CancellationToken *token);
+  void SetProgressCallback(TsmCallback callback);
+  void SetTourSource(TsmSource source);
 
  private:
-  void RunColony();
-  void RunAnts();
-  void UpdatePheromones();
-  void UpdateResult();
+  /**
+   * @brief Colony of ants with its own pheromones, an island of the
+   * algorithm. Ants of a colony run on the pool in blocks, one block per
+   * pheromone buffer.
+   *
+   */
+  class Colony {
+   public:
+    Colony(const AntAlgorithm &, uint64_t seed, ThreadPool *, size_t blocks);
+
+    void Start();
+    void Step();
+    void Accept(const TsmResult &migrant);
+    const TsmResult &GetBest() const;
+
+   private:
+    void RunAnts();
+    void DepositPheromones(size_t block);
+    void ResetPheromones(double pheromone);
+    void UpdatePheromones();
+    void UpdateMaxMin();
+    void UpdateEdge(int from, int to, double keep, double add);
+    void UpdateAttractiveness(size_t row);
+    void UpdateResult();
+    void ForEach(size_t count, const std::function<void(size_t)> &body);
+
+    const AntAlgorithm &algo_;
+    const Heuristics &consts_;
+    ThreadPool *pool_;
+    size_t blocks_;
+    Ants ants_;
+    Pheromones pheromones_;
+    std::vector<Pheromones> deltas_;
+    Attractiveness attractiveness_;
+    TsmResult result_;
+    TsmResult iteration_;
+    TsmResult best_;
+    size_t stagnation_ = 0;
+  };
+
+  void Migrate(std::vector<Colony> *colonies);
   bool CheckResult();
+  bool IsCancelled() const;
+  void Report(const TsmResult &result) const;
+  void Import(Colony *colony) const;
 
  private:
   const Graph &graph_;
+  uint64_t seed_;
+  size_t runs_ = 0;
   TsmResult result_;
-  Ants ants_;
-  Pheromones pheromones_;
+  TsmResult initial_;
+  Attractiveness visibility_;
   Heuristics consts_;
+  NeighbourLists neighbours_;
+  LocalSearch local_search_;
+  bool directed_;
+  double tour_scale_ = 0.0;
+  Mode mode_ = Mode::kAntSystem;
+  bool polish_ = false;
+  size_t iterations_;
+  size_t threads_ = 1;
+  size_t islands_ = 1;
+  size_t migration_;
+  const CancellationToken *token_ = nullptr;
+  TsmCallback callback_;
+  TsmSource tour_source_;
 };
 
 #endif  // SRC_LIB_ANT_ALGORITHM_H
@@ -0,0 +1,413 @@
+#include "branch_and_bound_algorithm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "lin_kernighan_algorithm.h"
+
+/**
+ * @brief Construct a new Branch And Bound Algorithm:: Branch And Bound
+ * Algorithm object
+ *
+ * @param graph
+ */
+BranchAndBoundAlgorithm::BranchAndBoundAlgorithm(const Graph &graph)
+    : graph_{graph}, symmetric_{!graph.IsDirected()} {}
+
+/**
+ * @brief Searches the paths from vertex 0 until every path is either a tour
+ * or cut off by the bound, or until the time is spent or the run is
+ * cancelled. Goes on from the bounds of FindLowerBound if it has been called.
+ *
+ */
+void BranchAndBoundAlgorithm::RunAlgorithm() {
+  const Graph::Matrix &m = graph_.GetGraph();
+  const int size = m.size();
+  if (!prepared_) FindLowerBound();
+  prepared_ = false;
+  if (size < 2) return;
+  nearest_.assign(size, {});
+  for (int v = 0; v < size; ++v) {
+    for (int u = 0; u < size; ++u) {
+      if (u != v && m[v][u] != 0) nearest_[v].push_back(u);
+    }
+    std::stable_sort(nearest_[v].begin(), nearest_[v].end(),
+                     [&m, v](int x, int y) { return m[v][x] < m[v][y]; });
+  }
+  visited_.assign(size, false);
+  visited_[0] = true;
+  path_.assign(1, 0);
+  Branch(0, 0);
+}
+
+/**
+ * @brief Finds the first upper bound and the penalties of the search and
+ * returns the lower bound of every tour: the penalized 1-tree on symmetric
+ * graphs, the reduction of the matrix on directed ones, rounded up as the
+ * lengths are integers. Infinity if there is no tour. The time limit counts
+ * from this call.
+ *
+ * @return double
+ */
+double BranchAndBoundAlgorithm::FindLowerBound() {
+  const Graph::Matrix &m = graph_.GetGraph();
+  const int size = m.size();
+  start_ = Clock::now();
+  nodes_ = 0;
+  optimal_ = true;
+  prepared_ = true;
+  best_.clear();
+  best_length_ = std::numeric_limits<long long>::max();
+  if (size == 1) {
+    best_ = {0, 0};
+    best_length_ = m[0][0];
+  }
+  if (size < 2) return size == 1 ? m[0][0] : 0.0;
+  FindUpperBound();
+  penalties_.assign(size, 0.0);
+  if (symmetric_) FindPenalties();
+  visited_.assign(size, false);
+  visited_[0] = true;
+  double bound = std::numeric_limits<double>::infinity();
+  if (size == 2) {
+    if (!best_.empty()) bound = best_length_;
+  } else if (symmetric_) {
+    std::vector<int> degrees;
+    bound = GetOneTree(&degrees);
+  } else {
+    bound = GetEdgesBound(0);
+  }
+  return std::ceil(bound - 1e-6);
+}
+
+/**
+ * @brief Returns the tour with the contract of
+ * GraphAlgorithms::SolveTravelingSalesmanProblem: one-based vertices closed
+ * by the first one
+ *
+ * @return TsmResult
+ */
+TsmResult BranchAndBoundAlgorithm::GetResult() const {
+  if (best_.empty()) {
+    throw std::logic_error(
+        "It is impossible to solve the problem with a given graph");
+  }
+  TsmResult result{best_, static_cast<double>(best_length_)};
+  for (int &v : result.vertices) ++v;
+  return result;
+}
+
+/**
+ * @brief Sets wall-clock limit of the search, 0 - no limit. A search stopped
+ * by the limit returns the shortest tour found.
+ *
+ * @param seconds
+ */
+void BranchAndBoundAlgorithm::SetTimeLimit(double seconds) {
+  time_limit_ = std::max(0.0, seconds);
+}
+
+/**
+ * @brief Sets the token stopping the search, nullptr - the search is not
+ * stopped. A cancelled search is not optimal and returns the shortest tour
+ * found.
+ *
+ * @param token Token outliving the run
+ */
+void BranchAndBoundAlgorithm::SetCancellationToken(
+    const CancellationToken *token) {
+  token_ = token;
+}
+
+/**
+ * @brief Sets the callback getting the first upper bound and every shorter
+ * tour of the search
+ *
+ * @param callback
+ */
+void BranchAndBoundAlgorithm::SetProgressCallback(TsmCallback callback) {
+  callback_ = std::move(callback);
+}
+
+/**
+ * @brief Returns true if the last search finished in time, so its tour is
+ * the shortest one or there is no tour at all
+ *
+ * @return true
+ * @return false
+ */
+bool BranchAndBoundAlgorithm::IsOptimal() const { return optimal_; }
+
+/**
+ * @brief Takes the tour of the Lin-Kernighan algorithm as the first upper
+ * bound, none if it has missed edges
+ *
+ */
+void BranchAndBoundAlgorithm::FindUpperBound() {
+  LinKernighanAlgorithm algo(graph_, 1);
+  algo.SetCancellationToken(token_);
+  algo.RunAlgorithm();
+  try {
+    TsmResult result = algo.GetResult();
+    best_ = result.vertices;
+    for (int &v : best_) --v;
+    best_length_ = result.distance;
+    Report();
+  } catch (const std::logic_error &) {
+  }
+}
+
+/**
+ * @brief Raises the 1-tree bound by subgradient optimization: the penalty of
+ * a vertex grows with its degree in the 1-tree over 2, so the tree tends to
+ * a tour. Keeps the penalties of the highest bound.
+ *
+ */
+void BranchAndBoundAlgorithm::FindPenalties() {
+  if (best_.empty() || graph_.GetGraph().size() < 3) return;
+  std::vector<double> best = penalties_;
+  std::vector<int> degrees;
+  double highest = -std::numeric_limits<double>::infinity(), step = 2.0;
+  for (size_t i = 0; i < consts_.kSubgradientSteps && !IsCancelled();
+       ++i, step *= 0.95) {
+    double bound = GetOneTree(&degrees);
+    if (bound == std::numeric_limits<double>::infinity()) break;
+    if (bound > highest) {
+      highest = bound;
+      best = penalties_;
+    }
+    long long norm = 0;
+    for (int degree : degrees) norm += (degree - 2) * (degree - 2);
+    if (norm == 0 || highest > best_length_ - 1) break;
+    double scale = step * (best_length_ - bound) / norm;
+    for (size_t v = 0; v < degrees.size(); ++v) {
+      penalties_[v] += scale * (degrees[v] - 2);
+    }
+  }
+  penalties_ = std::move(best);
+}
+
+/**
+ * @brief Returns the penalized 1-tree bound: a spanning tree of the vertices
+ * but 0 and the two cheapest edges of vertex 0. Infinity if the graph is
+ * disconnected.
+ *
+ * @param degrees Degrees of the vertices in the 1-tree
+ * @return double
+ */
+double BranchAndBoundAlgorithm::GetOneTree(std::vector<int> *degrees) {
+  const int size = graph_.GetGraph().size();
+  rest_.resize(size - 1);
+  std::iota(rest_.begin(), rest_.end(), 1);
+  degrees->assign(size, 0);
+  double tree = GetTree(rest_, degrees);
+  int first = -1, second = -1;
+  for (int v : rest_) {
+    if (Weight(0, v) == std::numeric_limits<double>::infinity()) continue;
+    if (first == -1 || Weight(0, v) < Weight(0, first)) {
+      second = first;
+      first = v;
+    } else if (second == -1 || Weight(0, v) < Weight(0, second)) {
+      second = v;
+    }
+  }
+  if (second == -1) return std::numeric_limits<double>::infinity();
+  (*degrees)[0] = 2;
+  ++(*degrees)[first];
+  ++(*degrees)[second];
+  double penalties =
+      std::accumulate(penalties_.begin(), penalties_.end(), 0.0);
+  return tree + Weight(0, first) + Weight(0, second) - 2 * penalties;
+}
+
+/**
+ * @brief Returns the bound of the rest of a symmetric tour: a path from the
+ * last vertex through the unvisited ones back to 0 costs at least their
+ * spanning tree and the cheapest edges to the tree from both of its ends
+ *
+ * @param last Last vertex of the path
+ * @return double
+ */
+double BranchAndBoundAlgorithm::GetTreeBound(int last) {
+  const double infinity = std::numeric_limits<double>::infinity();
+  rest_.clear();
+  double penalties = penalties_[last] + penalties_[0];
+  for (size_t v = 0; v < visited_.size(); ++v) {
+    if (visited_[v]) continue;
+    rest_.push_back(v);
+    penalties += 2 * penalties_[v];
+  }
+  double tree = GetTree(rest_, nullptr), from_last = infinity,
+         from_start = infinity;
+  for (int v : rest_) {
+    from_last = std::min(from_last, Weight(last, v));
+    from_start = std::min(from_start, Weight(0, v));
+  }
+  return tree + from_last + from_start - penalties;
+}
+
+/**
+ * @brief Returns the bound of the rest of a directed tour by reduction of the
+ * matrix of its edges: the last vertex and every unvisited one leave by an
+ * edge to an unvisited vertex or to 0, so each row costs at least its
+ * minimum. Each column is entered once, so it adds its minimum over the
+ * reduced rows.
+ *
+ * @param last Last vertex of the path
+ * @return double
+ */
+double BranchAndBoundAlgorithm::GetEdgesBound(int last) {
+  const double infinity = std::numeric_limits<double>::infinity();
+  rest_.assign(1, 0);
+  for (size_t v = 0; v < visited_.size(); ++v) {
+    if (!visited_[v]) rest_.push_back(v);
+  }
+  const size_t size = rest_.size();
+  key_.assign(size, infinity);
+  double bound = 0.0;
+  for (size_t i = 0; i < size; ++i) {
+    int from = i == 0 ? last : rest_[i];
+    double row = infinity;
+    for (size_t j = 0; j < size; ++j) {
+      if (rest_[j] != from) row = std::min(row, Weight(from, rest_[j]));
+    }
+    if (row == infinity) return infinity;
+    bound += row;
+    for (size_t j = 0; j < size; ++j) {
+      if (rest_[j] != from) {
+        key_[j] = std::min(key_[j], Weight(from, rest_[j]) - row);
+      }
+    }
+  }
+  for (double column : key_) bound += column;
+  return bound;
+}
+
+/**
+ * @brief Returns the penalized weight of the minimum spanning tree of the
+ * vertices by Prim's algorithm in O(k^2), infinity if they are disconnected
+ *
+ * @param vertices
+ * @param degrees Degrees of the vertices in the tree, may be null
+ * @return double
+ */
+double BranchAndBoundAlgorithm::GetTree(const std::vector<int> &vertices,
+                                        std::vector<int> *degrees) {
+  const double infinity = std::numeric_limits<double>::infinity();
+  const size_t size = vertices.size();
+  if (size == 0) return 0.0;
+  key_.assign(size, infinity);
+  parent_.assign(size, -1);
+  in_tree_.assign(size, false);
+  key_[0] = 0.0;
+  double tree = 0.0;
+  for (size_t step = 0; step < size; ++step) {
+    size_t current = size;
+    for (size_t i = 0; i < size; ++i) {
+      if (!in_tree_[i] && (current == size || key_[i] < key_[current])) {
+        current = i;
+      }
+    }
+    if (key_[current] == infinity) return infinity;
+    in_tree_[current] = true;
+    tree += key_[current];
+    if (degrees && parent_[current] != -1) {
+      ++(*degrees)[vertices[current]];
+      ++(*degrees)[vertices[parent_[current]]];
+    }
+    for (size_t i = 0; i < size; ++i) {
+      double weight = Weight(vertices[current], vertices[i]);
+      if (!in_tree_[i] && weight < key_[i]) {
+        key_[i] = weight;
+        parent_[i] = current;
+      }
+    }
+  }
+  return tree;
+}
+
+/**
+ * @brief Extends the path by every unvisited vertex, nearest first, unless
+ * the bound shows that the path can not give a shorter tour. Lengths are
+ * integers, so a bound above the best length minus one is enough.
+ *
+ * @param last Last vertex of the path
+ * @param length Length of the path
+ */
+void BranchAndBoundAlgorithm::Branch(int last, long long length) {
+  const Graph::Matrix &m = graph_.GetGraph();
+  if (!HasTime()) return;
+  if (path_.size() == m.size()) {
+    if (m[last][0] != 0 && length + m[last][0] < best_length_) {
+      best_ = path_;
+      best_.push_back(0);
+      best_length_ = length + m[last][0];
+      Report();
+    }
+    return;
+  }
+  double bound = symmetric_ ? GetTreeBound(last) : GetEdgesBound(last);
+  if (length + bound > best_length_ - 1 + 1e-6) return;
+  for (int v : nearest_[last]) {
+    if (visited_[v]) continue;
+    visited_[v] = true;
+    path_.push_back(v);
+    Branch(v, length + m[last][v]);
+    path_.pop_back();
+    visited_[v] = false;
+  }
+}
+
+/**
+ * @brief Returns false once the time is spent or the search is cancelled,
+ * the clock and the token are read every 256 nodes of the search
+ *
+ * @return true
+ * @return false
+ */
+bool BranchAndBoundAlgorithm::HasTime() {
+  if (!optimal_ || ++nodes_ % 256 != 0) return optimal_;
+  if (IsCancelled()) optimal_ = false;
+  if (time_limit_ > 0.0) {
+    std::chrono::duration<double> elapsed = Clock::now() - start_;
+    if (elapsed.count() >= time_limit_) optimal_ = false;
+  }
+  return optimal_;
+}
+
+/**
+ * @brief Returns true if the token of the search is cancelled
+ *
+ * @return true
+ * @return false
+ */
+bool BranchAndBoundAlgorithm::IsCancelled() const {
+  return token_ && token_->IsCancelled();
+}
+
+/**
+ * @brief Passes the shortest tour found to the callback as a cyclic one
+ *
+ */
+void BranchAndBoundAlgorithm::Report() const {
+  if (!callback_) return;
+  std::vector<int> tour(best_.begin(), best_.end() - 1);
+  callback_(TsmResult{tour, static_cast<double>(best_length_)});
+}
+
+/**
+ * @brief Returns weight of the edge with the penalties of its ends, infinity
+ * for missing edges
+ *
+ * @param from
+ * @param to
+ * @return double
+ */
+double BranchAndBoundAlgorithm::Weight(int from, int to) const {
+  int weight = graph_.GetGraph()[from][to];
+  if (weight == 0) return std::numeric_limits<double>::infinity();
+  return weight + penalties_[from] + penalties_[to];
+}
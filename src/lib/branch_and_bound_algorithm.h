@@ -0,0 +1,70 @@
+#ifndef SRC_LIB_BRANCH_AND_BOUND_ALGORITHM_H
+#define SRC_LIB_BRANCH_AND_BOUND_ALGORITHM_H
+
+#include <chrono>
+#include <vector>
+
+#include "../misc/cancellation_token.h"
+#include "heuristics.h"
+#include "s21_graph.h"
+#include "tsmresult.h"
+
+/**
+ * @brief Exact branch and bound for the traveling salesman's problem. Paths
+ * from vertex 0 grow by depth-first search, nearest vertices first, starting
+ * with the tour of the Lin-Kernighan algorithm as the upper bound. On
+ * symmetric graphs a path is cut off by a 1-tree bound over the rest of the
+ * vertices with the Held-Karp penalties found by subgradient optimization at
+ * the root; on directed graphs by the cheapest edges leaving the vertices.
+ *
+ */
+class BranchAndBoundAlgorithm {
+ public:
+  explicit BranchAndBoundAlgorithm(const Graph &);
+
+  void RunAlgorithm();
+  double FindLowerBound();
+  TsmResult GetResult() const;
+  void SetTimeLimit(double seconds);
+  void SetCancellationToken(const CancellationToken *token);
+  void SetProgressCallback(TsmCallback callback);
+  bool IsOptimal() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  void FindUpperBound();
+  void FindPenalties();
+  double GetOneTree(std::vector<int> *degrees);
+  double GetTreeBound(int last);
+  double GetEdgesBound(int last);
+  double GetTree(const std::vector<int> &vertices, std::vector<int> *degrees);
+  void Branch(int last, long long length);
+  bool HasTime();
+  bool IsCancelled() const;
+  void Report() const;
+  double Weight(int from, int to) const;
+
+  const Graph &graph_;
+  const Heuristics consts_;
+  bool symmetric_;
+  double time_limit_ = 0.0;
+  const CancellationToken *token_ = nullptr;
+  TsmCallback callback_;
+  bool prepared_ = false;
+  bool optimal_ = false;
+  Clock::time_point start_;
+  size_t nodes_ = 0;
+  std::vector<double> penalties_;
+  std::vector<std::vector<int>> nearest_;
+  std::vector<char> visited_;
+  std::vector<int> path_;
+  std::vector<int> rest_;
+  std::vector<double> key_;
+  std::vector<int> parent_;
+  std::vector<char> in_tree_;
+  std::vector<int> best_;
+  long long best_length_ = 0;
+};
+
+#endif  // SRC_LIB_BRANCH_AND_BOUND_ALGORITHM_H
@@ -0,0 +1,219 @@
+#include "delta_stepping.h"
+
+#include <limits>
+#include <memory>
+
+/**
+ * @brief Construct a new Delta Stepping:: Delta Stepping object. Splits edges
+ * into light ones, not heavier than delta, and heavy ones.
+ *
+ * @param graph
+ * @param delta Width of a bucket, 0 - chosen from the weights by ChooseDelta
+ */
+DeltaStepping::DeltaStepping(const Graph &graph, int delta)
+    : graph_{graph}, delta_{delta > 0 ? delta : ChooseDelta(graph)} {
+  const Graph::Matrix &m = graph_.GetGraph();
+  light_.resize(m.size());
+  heavy_.resize(m.size());
+  for (size_t i = 0; i < m.size(); ++i) {
+    for (size_t j = 0; j < m.size(); ++j) {
+      if (m[i][j] == 0 or i == j) continue;
+      Edge edge{static_cast<int>(j), m[i][j]};
+      if (m[i][j] <= delta_) {
+        light_[i].push_back(edge);
+      } else {
+        heavy_[i].push_back(edge);
+      }
+      max_weight_ = std::max(max_weight_, m[i][j]);
+    }
+  }
+}
+
+/**
+ * @brief Returns bucket width for the graph: the largest weight divided by the
+ * average vertex degree, but not less than the smallest weight. So a vertex
+ * has about one light edge per bucket on random weights.
+ *
+ * @param graph
+ * @return int
+ */
+int DeltaStepping::ChooseDelta(const Graph &graph) {
+  const Graph::Matrix &m = graph.GetGraph();
+  long long edges = 0;
+  int min_weight = std::numeric_limits<int>::max(), max_weight = 0;
+  for (size_t i = 0; i < m.size(); ++i) {
+    for (size_t j = 0; j < m.size(); ++j) {
+      if (m[i][j] == 0 or i == j) continue;
+      ++edges;
+      min_weight = std::min(min_weight, m[i][j]);
+      max_weight = std::max(max_weight, m[i][j]);
+    }
+  }
+  if (edges == 0) return 1;
+  long long degree = std::max(1LL, edges / static_cast<long long>(m.size()));
+  return std::max(min_weight, static_cast<int>(max_weight / degree));
+}
+
+/**
+ * @brief Runs Delta Stepping from the source vertex. Buckets are processed in
+ * increasing order: light edges of the bucket are relaxed in phases until it
+ * stays empty, then heavy edges of all vertices removed from it are relaxed
+ * once.
+ *
+ * @param source Zero-based starting vertex
+ */
+void DeltaStepping::RunAlgorithm(int source) {
+  const size_t size = graph_.GetGraph().size();
+  slots_ = max_weight_ / delta_ + 2;
+  distance_.assign(size, std::numeric_limits<int>::max());
+  settled_.assign(size, 0);
+  frontier_mark_.assign(size, 0);
+  round_ = 0;
+  buckets_.assign(threads_, Buckets(slots_));
+  frontier_.assign(threads_, Vector());
+  removed_.assign(threads_, Vector());
+  requests_.assign(threads_, Requests(threads_));
+  std::unique_ptr<ThreadPool> pool;
+  if (threads_ > 1) pool = std::make_unique<ThreadPool>(threads_);
+  auto for_each_owner = [this, &pool](auto body) {
+    if (pool) {
+      pool->ParallelFor(threads_, [&body](size_t owner, size_t) {
+        body(owner);
+      });
+    } else {
+      for (size_t owner = 0; owner < threads_; ++owner) body(owner);
+    }
+  };
+
+  distance_[source] = 0;
+  buckets_[source % threads_][0].push_back(source);
+  size_t bucket = 0;
+  while (FindNextBucket(&bucket)) {
+    while (true) {
+      ++round_;
+      for_each_owner([&](size_t owner) { CollectFrontier(owner, bucket); });
+      if (std::all_of(frontier_.begin(), frontier_.end(),
+                      [](const Vector &f) { return f.empty(); })) {
+        break;
+      }
+      for_each_owner([&](size_t owner) {
+        MakeRequests(owner, light_, frontier_[owner]);
+      });
+      for_each_owner([&](size_t owner) { ApplyRequests(owner); });
+    }
+    for_each_owner([&](size_t owner) {
+      MakeRequests(owner, heavy_, removed_[owner]);
+      removed_[owner].clear();
+    });
+    for_each_owner([&](size_t owner) { ApplyRequests(owner); });
+  }
+  std::replace(distance_.begin(), distance_.end(),
+               std::numeric_limits<int>::max(), -1);
+}
+
+/**
+ * @brief Returns the distances from the source, -1 for unreachable vertices
+ *
+ * @return DeltaStepping::Vector
+ */
+DeltaStepping::Vector DeltaStepping::GetResult() const { return distance_; }
+
+/**
+ * @brief Returns width of a bucket
+ *
+ * @return int
+ */
+int DeltaStepping::GetDelta() const { return delta_; }
+
+/**
+ * @brief Sets number of threads, 0 - number of hardware threads
+ *
+ * @param threads
+ */
+void DeltaStepping::SetThreadsCount(size_t threads) {
+  threads_ = threads ? threads : ThreadPool::DefaultThreadsCount();
+}
+
+/**
+ * @brief Moves vertices of the owner from the bucket to its frontier. Entries
+ * left behind by a later decrease of the distance are dropped.
+ *
+ * @param owner
+ * @param bucket
+ */
+void DeltaStepping::CollectFrontier(size_t owner, size_t bucket) {
+  Vector entries;
+  entries.swap(buckets_[owner][bucket % slots_]);
+  frontier_[owner].clear();
+  for (int v : entries) {
+    if (static_cast<size_t>(distance_[v] / delta_) != bucket or
+        frontier_mark_[v] == round_) {
+      continue;
+    }
+    frontier_mark_[v] = round_;
+    frontier_[owner].push_back(v);
+    if (settled_[v] != bucket + 1) {
+      settled_[v] = bucket + 1;
+      removed_[owner].push_back(v);
+    }
+  }
+}
+
+/**
+ * @brief Puts relaxation requests for the edges of the vertices into the
+ * buffers of the owner, one buffer per owner of the edge end
+ *
+ * @param owner
+ * @param edges Light or heavy edges
+ * @param vertices
+ */
+void DeltaStepping::MakeRequests(size_t owner, const std::vector<Edges> &edges,
+                                 const Vector &vertices) {
+  for (int v : vertices) {
+    for (const Edge &edge : edges[v]) {
+      int distance = distance_[v] + edge.weight;
+      if (distance < distance_[edge.to]) {
+        requests_[owner][edge.to % threads_].push_back({edge.to, distance});
+      }
+    }
+  }
+}
+
+/**
+ * @brief Relaxes the requests addressed to the vertices of the owner
+ *
+ * @param owner
+ */
+void DeltaStepping::ApplyRequests(size_t owner) {
+  for (size_t from = 0; from < threads_; ++from) {
+    for (const Request &request : requests_[from][owner]) {
+      if (request.distance < distance_[request.vertex]) {
+        distance_[request.vertex] = request.distance;
+        buckets_[owner][request.distance / delta_ % slots_].push_back(
+            request.vertex);
+      }
+    }
+    requests_[from][owner].clear();
+  }
+}
+
+/**
+ * @brief Finds the first non-empty bucket starting from the given one. All
+ * the tentative distances lie within max weight of the current bucket, so the
+ * cyclic buckets are searched once around.
+ *
+ * @param bucket
+ * @return true
+ * @return false if all buckets are empty
+ */
+bool DeltaStepping::FindNextBucket(size_t *bucket) const {
+  for (size_t i = *bucket; i < *bucket + slots_; ++i) {
+    for (const Buckets &buckets : buckets_) {
+      if (!buckets[i % slots_].empty()) {
+        *bucket = i;
+        return true;
+      }
+    }
+  }
+  return false;
+}
@@ -0,0 +1,64 @@
+#ifndef SRC_LIB_DELTA_STEPPING_H
+#define SRC_LIB_DELTA_STEPPING_H
+
+#include <vector>
+
+#include "../misc/thread_pool.h"
+#include "s21_graph.h"
+
+/**
+ * @brief Parallel single-source shortest paths by the delta-stepping
+ * algorithm of Meyer and Sanders. Vertices are owned by threads by their
+ * index, so each thread relaxes and buckets only its own vertices.
+ *
+ */
+class DeltaStepping {
+ public:
+  using Vector = std::vector<int>;
+
+  explicit DeltaStepping(const Graph &, int delta = 0);
+
+  void RunAlgorithm(int source);
+  Vector GetResult() const;
+  int GetDelta() const;
+  void SetThreadsCount(size_t threads);
+
+  static int ChooseDelta(const Graph &);
+
+ private:
+  struct Edge {
+    int to;
+    int weight;
+  };
+  struct Request {
+    int vertex;
+    int distance;
+  };
+  using Edges = std::vector<Edge>;
+  using Requests = std::vector<std::vector<Request>>;
+  using Buckets = std::vector<std::vector<int>>;
+
+  void CollectFrontier(size_t owner, size_t bucket);
+  void MakeRequests(size_t owner, const std::vector<Edges> &edges,
+                    const Vector &vertices);
+  void ApplyRequests(size_t owner);
+  bool FindNextBucket(size_t *bucket) const;
+
+  const Graph &graph_;
+  int delta_;
+  int max_weight_ = 0;
+  size_t slots_ = 0;
+  size_t threads_ = 1;
+  std::vector<Edges> light_;
+  std::vector<Edges> heavy_;
+  Vector distance_;
+  std::vector<size_t> settled_;
+  std::vector<size_t> frontier_mark_;
+  size_t round_ = 0;
+  std::vector<Buckets> buckets_;
+  std::vector<Vector> frontier_;
+  std::vector<Vector> removed_;
+  std::vector<Requests> requests_;
+};
+
+#endif  // SRC_LIB_DELTA_STEPPING_H
@@ -1,138 +1,448 @@
 #include "./genetic_algorithm.h"
 
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "tour_construction.h"
+
 /**
  * @brief Construct a new Genetic Algorithm:: Genetic Algorithm object
  *
  * @param graph
+ * @param seed Seed of the random generator, islands get independent streams
  */
-GeneticAlgorithm::GeneticAlgorithm(const Graph &graph)
-    : graph_{graph.GetGraph()} {}
+GeneticAlgorithm::GeneticAlgorithm(const Graph &graph, uint64_t seed)
+    : graph_{graph.GetGraph()},
+      source_{graph},
+      seed_{seed},
+      population_{consts_.kGenerationSize},
+      mutations_{graph.GetGraph().size() / consts_.kMutation},
+      generations_{consts_.kGenerationsCount},
+      migration_{consts_.kMigration} {}
 
 /**
- * @brief Runs Genetic Algotithm on loaded graph
+ * @brief Runs Genetic Algotithm on loaded graph. Every island runs all the
+ * generations, islands run concurrently in epochs of migration_ generations
+ * and exchange their best members between the epochs. A single island breeds
+ * its children on all the threads instead. A cancelled run stops after the
+ * current generation with the fittest member found. Every run takes a new
+ * stream of the seed, so repeated runs give different tours. A shorter tour
+ * of the source joins the island as an immigrant after every generation.
  *
  */
 void GeneticAlgorithm::RunAlgorithm() {
-  Generation generation = MakeGeneration();
-  for (size_t i = 0; i < generation.size(); ++i) {
-    population_.insert(
-        std::pair<int, Individual>(GetFitness(generation[i]), generation[i]));
-  }
-  for (size_t i = 0; i < consts_.kGenerationsCount; ++i) {
-    auto it = population_.begin();
-    ++it;
-    Offspring offspring =
-        Procreate((*(population_.begin())).second, (*it).second);
-    Mutate(&offspring.first);
-    Mutate(&offspring.second);
-    population_.insert(std::pair<int, Individual>(GetFitness(offspring.first),
-                                                  offspring.first));
-    population_.insert(std::pair<int, Individual>(GetFitness(offspring.second),
-                                                  offspring.second));
-    population_.erase(--(population_.end()));
-    population_.erase(--(population_.end()));
-  }
-  Individual ind;
-  for (size_t i = 0; i < (*(population_.begin())).second.size(); ++i) {
-    ind.push_back((*(population_.begin())).second[i]);
-  }
-  result_.vertices = ind;
-  result_.distance = (*(population_.begin())).first;
-}
-
-/**
- * @brief Returns random generation
- *
- * @return GeneticAlgorithm::Generation
- */
-GeneticAlgorithm::Generation GeneticAlgorithm::MakeGeneration() {
-  Generation generation(consts_.kGenerationSize);
-  Individual ind;
-  for (size_t i = 0; i < graph_.size(); ++i) {
-    ind.push_back(i + 1);
-  }
-  for (size_t i = 0; i < consts_.kGenerationSize; ++i) {
-    std::shuffle(ind.begin(), ind.end(), std::mt19937(std::random_device()()));
-    for (size_t j = 0; j < ind.size(); ++j) {
-      generation[i].push_back(ind[j]);
+  const size_t pairs = tournament_ ? std::max<size_t>(1, population_ / 2) : 1;
+  const size_t islands = std::max<size_t>(1, islands_);
+  if (crossover_ == Crossover::kEdgeAssembly) {
+    neighbours_ =
+        std::make_unique<NeighbourLists>(source_, consts_.kNeighbours);
+  }
+  if (polish_) local_search_ = std::make_unique<LocalSearch>(source_);
+  size_t threads = std::min(threads_, islands > 1 ? islands : pairs);
+  std::unique_ptr<ThreadPool> pool;
+  if (threads > 1) pool = std::make_unique<ThreadPool>(threads);
+  const uint64_t seed = Random::DeriveRun(seed_, runs_++);
+  std::vector<Island> populations;
+  populations.reserve(islands);
+  for (size_t i = 0; i < islands; ++i) {
+    if (islands > 1) {
+      populations.emplace_back(*this, Random::Derive(seed, i), nullptr, 1);
+    } else {
+      populations.emplace_back(*this, Random::Derive(seed, i), pool.get(),
+                               std::max<size_t>(1, threads));
+    }
+  }
+  Random random(Random::Derive(seed, islands));
+  const size_t epoch = migration_ ? migration_ : generations_;
+  std::vector<int> reported(islands, std::numeric_limits<int>::max());
+  for (size_t done = 0; done < generations_; done += epoch) {
+    size_t last = std::min(done + epoch, generations_);
+    auto run = [this, &populations, &reported, done, last](size_t island) {
+      for (size_t i = done; i < last && !IsCancelled(); ++i) {
+        populations[island].Step();
+        const Member &best = populations[island].GetBest();
+        if (best.fitness < reported[island]) {
+          reported[island] = best.fitness;
+          Report(best.genes);
+        }
+        Import(&populations[island]);
+      }
+    };
+    if (pool && islands > 1) {
+      pool->ParallelFor(islands, [&run](size_t island, size_t) {
+        run(island);
+      });
+    } else {
+      for (size_t island = 0; island < islands; ++island) run(island);
     }
+    if (IsCancelled()) break;
+    if (last < generations_) Migrate(&populations, &random);
   }
-  return generation;
+  const Member *best = &populations[0].GetBest();
+  for (const Island &island : populations) {
+    if (island.GetBest().fitness < best->fitness) best = &island.GetBest();
+  }
+  result_.vertices.clear();
+  result_.distance = best->fitness;
+  if (!best->genes.empty() &&
+      best->fitness != std::numeric_limits<int>::max()) {
+    const Individual &genes = best->genes;
+    auto first = std::find(genes.begin(), genes.end(), 1);
+    result_.vertices.assign(first, genes.end());
+    result_.vertices.insert(result_.vertices.end(), genes.begin(), first + 1);
+  }
+  neighbours_.reset();
+  local_search_.reset();
 }
 
 /**
- * @brief Simulates breeding process
+ * @brief Sets the crossover, the prefix one by default
  *
- * @param Individual
- * @param Individual
- * @return GeneticAlgorithm::Offspring
+ * @param crossover
  */
-GeneticAlgorithm::Offspring GeneticAlgorithm::Procreate(Individual &ancestor1,
-                                                        Individual &ancestor2) {
-  Individual offspring1, offspring2;
-  int choice = RandomChoice(1, ancestor1.size());
-  for (int i = 0; i < choice; ++i) {
-    offspring1.push_back(ancestor1[i]);
-    offspring2.push_back(ancestor2[i]);
+void GeneticAlgorithm::SetCrossover(Crossover crossover) {
+  crossover_ = crossover;
+}
+
+/**
+ * @brief Sets number of members of the population of every island,
+ * kGenerationSize by default
+ *
+ * @param size
+ */
+void GeneticAlgorithm::SetPopulationSize(size_t size) {
+  population_ = std::max<size_t>(2, size);
+}
+
+/**
+ * @brief Sets number of members competing for every parent, 0 - the two
+ * fittest members are the only parents
+ *
+ * @param size
+ */
+void GeneticAlgorithm::SetTournamentSize(size_t size) { tournament_ = size; }
+
+/**
+ * @brief Sets number of random swaps of genes in every child, n / kMutation
+ * by default
+ *
+ * @param count
+ */
+void GeneticAlgorithm::SetMutationsCount(size_t count) { mutations_ = count; }
+
+/**
+ * @brief Sets number of generations, kGenerationsCount by default
+ *
+ * @param generations
+ */
+void GeneticAlgorithm::SetGenerationsCount(size_t generations) {
+  generations_ = generations;
+}
+
+/**
+ * @brief Sets number of threads running the islands, or breeding the
+ * children if there is one island, 0 - number of hardware threads. Every
+ * pair of children has its own generator, so equal seeds give equal results
+ * on any number of threads.
+ *
+ * @param threads
+ */
+void GeneticAlgorithm::SetThreadsCount(size_t threads) {
+  threads_ = threads ? threads : ThreadPool::DefaultThreadsCount();
+}
+
+/**
+ * @brief Sets number of islands, one by default, 0 - number of hardware
+ * threads. Every island has a population of its own and runs all the
+ * generations.
+ *
+ * @param islands
+ */
+void GeneticAlgorithm::SetIslandsCount(size_t islands) {
+  islands_ = islands ? islands : ThreadPool::DefaultThreadsCount();
+}
+
+/**
+ * @brief Sets number of generations between migrations, kMigration by
+ * default, 0 - islands never exchange members
+ *
+ * @param generations
+ */
+void GeneticAlgorithm::SetMigrationInterval(size_t generations) {
+  migration_ = generations;
+}
+
+/**
+ * @brief Sets number of the best members every island sends on a migration,
+ * one by default
+ *
+ * @param count
+ */
+void GeneticAlgorithm::SetMigrantsCount(size_t count) { migrants_ = count; }
+
+/**
+ * @brief Sets routes of the migrants, the ring by default
+ *
+ * @param topology
+ */
+void GeneticAlgorithm::SetTopology(Topology topology) { topology_ = topology; }
+
+/**
+ * @brief Enables 2-opt and Or-opt improvement of every new member, which
+ * makes the algorithm a memetic one
+ *
+ * @param enabled
+ */
+void GeneticAlgorithm::SetLocalSearch(bool enabled) { polish_ = enabled; }
+
+/**
+ * @brief Sets the tour the first member of every island starts from, the
+ * rest of the population starts from its copies with kSeedSwaps random swaps
+ * of genes, an empty tour makes the population random
+ *
+ * @param tour Zero-based permutation of the vertices
+ */
+void GeneticAlgorithm::SetInitialTour(const Individual &tour) {
+  if (!tour.empty() && !TourConstruction::IsTour(tour, graph_.size())) {
+    throw std::logic_error("The initial tour is not a permutation of vertices");
   }
-  for (size_t i = 0; i < ancestor1.size(); ++i) {
-    if (!IsGeneInOffspring(offspring1, ancestor2[i])) {
-      offspring1.push_back(ancestor2[i]);
+  initial_ = tour;
+  for (int &gene : initial_) ++gene;
+}
+
+/**
+ * @brief Sets the token stopping the run, nullptr - the run is not stopped
+ *
+ * @param token Token outliving the run
+ */
+void GeneticAlgorithm::SetCancellationToken(const CancellationToken *token) {
+  token_ = token;
+}
+
+/**
+ * @brief Sets the callback getting the fittest member of an island whenever
+ * it changes, as a cyclic tour of its genes. Islands running in different
+ * threads may call it concurrently.
+ *
+ * @param callback
+ */
+void GeneticAlgorithm::SetProgressCallback(TsmCallback callback) {
+  callback_ = std::move(callback);
+}
+
+/**
+ * @brief Sets the source of shorter tours joining the islands as immigrants,
+ * nullptr - the tours are not shared. Islands running in different threads
+ * may call it concurrently.
+ *
+ * @param source
+ */
+void GeneticAlgorithm::SetTourSource(TsmSource source) {
+  tour_source_ = std::move(source);
+}
+
+/**
+ * @brief Sends the best members of every island to the next island of the
+ * ring or to a random other island. The migrants are copied before any
+ * island takes them, so they move one hop per migration.
+ *
+ * @param islands
+ * @param random Generator of the random routes
+ */
+void GeneticAlgorithm::Migrate(std::vector<Island> *islands,
+                               Random *random) const {
+  const size_t count = islands->size();
+  if (count < 2 || migrants_ == 0) return;
+  std::vector<std::vector<Member>> migrants(count);
+  for (size_t i = 0; i < count; ++i) (*islands)[i].Emigrate(&migrants[i]);
+  for (size_t i = 0; i < count; ++i) {
+    size_t target = (i + 1) % count;
+    if (topology_ == Topology::kRandom) {
+      target = (i + 1 + random->NextInt(0, count - 2)) % count;
     }
-    if (!IsGeneInOffspring(offspring2, ancestor1[i])) {
-      offspring2.push_back(ancestor1[i]);
+    (*islands)[target].Accept(migrants[i]);
+  }
+}
+
+/**
+ * @brief Construct a new Genetic Algorithm:: Island:: Island object with a
+ * random population, or one around the initial tour if there is one, and
+ * spare members for the children
+ *
+ * @param algo Algorithm sharing the graph and the settings
+ * @param seed Seed of the island
+ * @param pool Pool breeding the children, nullptr - they breed in the caller
+ * @param breeders Number of breeders, one per thread of the pool
+ */
+GeneticAlgorithm::Island::Island(const GeneticAlgorithm &algo, uint64_t seed,
+                                 ThreadPool *pool, size_t breeders)
+    : algo_(algo),
+      pool_(pool),
+      random_(seed),
+      pairs_(algo.tournament_ ? std::max<size_t>(1, algo.population_ / 2)
+                              : 1) {
+  for (size_t i = 0; i < breeders; ++i) breeders_.emplace_back(algo);
+  Individual ind(algo.graph_.size());
+  std::iota(ind.begin(), ind.end(), 1);
+  const Member spare{std::numeric_limits<int>::max(),
+                     std::numeric_limits<size_t>::max(), ind};
+  members_.assign(algo.population_ + 2 * pairs_, spare);
+  order_.resize(members_.size());
+  std::iota(order_.begin(), order_.end(), 0);
+  clones_.reserve(members_.size());
+  parents_.resize(2 * pairs_);
+  for (size_t i = 0; i < algo.population_; ++i) {
+    if (algo.initial_.empty()) {
+      random_.Shuffle(ind.begin(), ind.end());
+      members_[i].genes = ind;
+    } else {
+      members_[i].genes = algo.initial_;
+      for (size_t k = 0; i > 0 && k < algo.consts_.kSeedSwaps; ++k) {
+        std::swap(members_[i].genes[random_.NextInt(0, ind.size() - 1)],
+                  members_[i].genes[random_.NextInt(0, ind.size() - 1)]);
+      }
     }
+    breeders_[0].Polish(&members_[i].genes);
+    members_[i].fitness = algo.GetFitness(members_[i].genes);
+    members_[i].birth = births_++;
   }
-  return Offspring(offspring1, offspring2);
+  Select();
 }
 
 /**
- * @brief Randomly cnanges genes
+ * @brief Runs one generation. Without tournaments the two fittest members
+ * breed once, with tournaments the generation breeds as many children as
+ * there are members. Children take the spare slots behind the population,
+ * the least fit members and the clones become the new spare slots.
  *
- * @param Individual
  */
-void GeneticAlgorithm::Mutate(Individual *ind) {
-  for (size_t i = 0; i < graph_.size() / consts_.kMutation; ++i) {
-    int idx1 = RandomChoice(0, ind->size() - 1);
-    int idx2 = RandomChoice(0, ind->size() - 1);
-    std::swap(ind->at(idx1), ind->at(idx2));
+void GeneticAlgorithm::Island::Step() {
+  Breed();
+  Select();
+}
+
+/**
+ * @brief Copies the best members of the island
+ *
+ * @param migrants
+ */
+void GeneticAlgorithm::Island::Emigrate(std::vector<Member> *migrants) const {
+  size_t count = std::min(algo_.migrants_, algo_.population_ - 1);
+  migrants->clear();
+  for (size_t i = 0; i < count; ++i) migrants->push_back(members_[order_[i]]);
+}
+
+/**
+ * @brief Replaces the least fit members of the population by the migrants
+ *
+ * @param migrants
+ */
+void GeneticAlgorithm::Island::Accept(const std::vector<Member> &migrants) {
+  for (size_t i = 0; i < migrants.size(); ++i) {
+    Member &member = members_[order_[algo_.population_ - 1 - i]];
+    member.genes = migrants[i].genes;
+    member.fitness = migrants[i].fitness;
+    member.birth = births_++;
   }
+  Select();
 }
 
 /**
- * @brief Returns true if gene in offspring, otherwise - false
+ * @brief Returns the fittest member of the island
  *
- * @param Individual
- * @param gene
- * @return true
- * @return false
+ * @return const GeneticAlgorithm::Member&
  */
-bool GeneticAlgorithm::IsGeneInOffspring(const Individual &ind, int gene) {
-  for (size_t i = 0; i < ind.size(); ++i) {
-    if (gene == ind[i]) return true;
+const GeneticAlgorithm::Member &GeneticAlgorithm::Island::GetBest() const {
+  return members_[order_[0]];
+}
+
+/**
+ * @brief Chooses the parents and breeds the children into the spare slots,
+ * pairs of children are bred and evaluated in parallel
+ *
+ */
+void GeneticAlgorithm::Island::Breed() {
+  const size_t population = algo_.population_;
+  for (size_t i = 0; i < 2 * pairs_; ++i) {
+    parents_[i] = algo_.tournament_ ? Tournament() : order_[i % 2];
   }
-  return false;
+  const uint64_t seed = random_();
+  ForEach(pairs_, [this, seed, population](size_t pair, size_t thread) {
+    Random random(Random::Derive(seed, pair));
+    Member &child1 = members_[order_[population + 2 * pair]];
+    Member &child2 = members_[order_[population + 2 * pair + 1]];
+    Breeder &breeder = breeders_[thread];
+    breeder.Procreate(members_[parents_[2 * pair]].genes,
+                      members_[parents_[2 * pair + 1]].genes, &random,
+                      &child1.genes, &child2.genes);
+    breeder.Mutate(&child1.genes, &random);
+    breeder.Mutate(&child2.genes, &random);
+    breeder.Polish(&child1.genes);
+    breeder.Polish(&child2.genes);
+    child1.fitness = algo_.GetFitness(child1.genes);
+    child2.fitness = algo_.GetFitness(child2.genes);
+    child1.birth = births_ + 2 * pair;
+    child2.birth = births_ + 2 * pair + 1;
+  });
+  births_ += 2 * pairs_;
 }
 
 /**
- * @brief Calculates optimized value
+ * @brief Orders all the members by fitness, the older first among equally
+ * fit ones. A member as fit as the previous one is most likely its clone, so
+ * such members go behind the rest and do not take over the population.
  *
- * @param Individual
- * @return int
  */
-int GeneticAlgorithm::GetFitness(const Individual &ind) {
-  if (ind.size() == 0) return -1;
-  if (graph_[0][ind[0] - 1] == 0 or graph_[ind.back() - 1][0] == 0)
-    return std::numeric_limits<int>::max();
+void GeneticAlgorithm::Island::Select() {
+  std::sort(order_.begin(), order_.end(), [this](size_t a, size_t b) {
+    const Member &member1 = members_[a];
+    const Member &member2 = members_[b];
+    if (member1.fitness != member2.fitness) {
+      return member1.fitness < member2.fitness;
+    }
+    return member1.birth < member2.birth;
+  });
+  clones_.clear();
+  size_t unique = 0;
+  for (size_t i = 0; i < order_.size(); ++i) {
+    int fitness = members_[order_[i]].fitness;
+    if (unique > 0 && fitness == members_[order_[unique - 1]].fitness) {
+      clones_.push_back(order_[i]);
+    } else {
+      order_[unique++] = order_[i];
+    }
+  }
+  std::copy(clones_.begin(), clones_.end(), order_.begin() + unique);
+}
 
-  int fitness = graph_[0][ind[0] - 1] + graph_[ind.back() - 1][0];
+/**
+ * @brief Returns the fittest of tournament_ random members of the population
+ *
+ * @return size_t
+ */
+size_t GeneticAlgorithm::Island::Tournament() {
+  size_t best = algo_.population_;
+  for (size_t i = 0; i < algo_.tournament_; ++i) {
+    best = std::min<size_t>(best, RandomChoice(0, algo_.population_ - 1));
+  }
+  return order_[best];
+}
 
-  for (size_t i = 0; i < ind.size() - 1; ++i) {
-    if (graph_[ind[i] - 1][ind[i + 1] - 1] == 0)
-      return std::numeric_limits<int>::max();
-    fitness += graph_[ind[i] - 1][ind[i + 1] - 1];
+/**
+ * @brief Calls body(index, thread) for every index in [0, count), on the pool
+ * if there is one
+ *
+ * @param count
+ * @param body
+ */
+void GeneticAlgorithm::Island::ForEach(
+    size_t count, const std::function<void(size_t, size_t)> &body) {
+  if (pool_) {
+    pool_->ParallelFor(count, body);
+  } else {
+    for (size_t i = 0; i < count; ++i) body(i, 0);
   }
-  return fitness;
 }
 
 /**
@@ -142,15 +452,527 @@ int GeneticAlgorithm::GetFitness(const Individual &ind) {
  * @param max right border of range
  * @return int
  */
-int GeneticAlgorithm::RandomChoice(int min, int max) {
-  std::uniform_int_distribution<int> dist(min, max);
-  std::random_device rd;
-  return dist(rd);
+int GeneticAlgorithm::Island::RandomChoice(int min, int max) {
+  return random_.NextInt(min, max);
+}
+
+/**
+ * @brief Construct a new Genetic Algorithm:: Breeder:: Breeder object with
+ * buffers for the graph of the algorithm
+ *
+ * @param algo
+ */
+GeneticAlgorithm::Breeder::Breeder(const GeneticAlgorithm &algo)
+    : algo_(algo),
+      taken_(algo.graph_.size()),
+      position_(algo.graph_.size()),
+      links_a_(algo.graph_.size()),
+      links_b_(algo.graph_.size()),
+      links_(algo.graph_.size()),
+      free_a_(algo.graph_.size()),
+      free_b_(algo.graph_.size()),
+      label_(algo.graph_.size()),
+      tour_(algo.graph_.size()) {
+  const size_t size = algo.graph_.size();
+  starts_.reserve(size);
+  path_.reserve(2 * size);
+  sizes_.reserve(size);
+  heads_.reserve(size);
+  subtour_.reserve(size);
+}
+
+/**
+ * @brief Simulates breeding process, both children get the same cut points
+ *
+ * @param ancestor1
+ * @param ancestor2
+ * @param random Generator of the pair
+ * @param offspring1 Buffer of the size of the ancestors
+ * @param offspring2 Buffer of the size of the ancestors
+ */
+void GeneticAlgorithm::Breeder::Procreate(const Individual &ancestor1,
+                                          const Individual &ancestor2,
+                                          Random *random,
+                                          Individual *offspring1,
+                                          Individual *offspring2) {
+  const int size = ancestor1.size();
+  if (algo_.crossover_ == Crossover::kPrefix) {
+    int choice = random->NextInt(1, size);
+    Prefix(ancestor1, ancestor2, choice, offspring1);
+    Prefix(ancestor2, ancestor1, choice, offspring2);
+  } else if (algo_.crossover_ == Crossover::kEdgeAssembly) {
+    EdgeAssembly(ancestor1, ancestor2, random, offspring1);
+    EdgeAssembly(ancestor2, ancestor1, random, offspring2);
+  } else {
+    int left = random->NextInt(0, size - 1);
+    int right = random->NextInt(0, size - 1);
+    if (left > right) std::swap(left, right);
+    if (algo_.crossover_ == Crossover::kOrder) {
+      Order(ancestor1, ancestor2, left, right, offspring1);
+      Order(ancestor2, ancestor1, left, right, offspring2);
+    } else {
+      PartiallyMapped(ancestor1, ancestor2, left, right, offspring1);
+      PartiallyMapped(ancestor2, ancestor1, left, right, offspring2);
+    }
+  }
+}
+
+/**
+ * @brief Randomly cnanges genes
+ *
+ * @param ind
+ * @param random Generator of the pair
+ */
+void GeneticAlgorithm::Breeder::Mutate(Individual *ind, Random *random) const {
+  for (size_t i = 0; i < algo_.mutations_; ++i) {
+    int idx1 = random->NextInt(0, ind->size() - 1);
+    int idx2 = random->NextInt(0, ind->size() - 1);
+    std::swap((*ind)[idx1], (*ind)[idx2]);
+  }
+}
+
+/**
+ * @brief Improves the individual as a cyclic tour if local search is enabled
+ *
+ * @param ind
+ */
+void GeneticAlgorithm::Breeder::Polish(Individual *ind) {
+  if (!algo_.local_search_) return;
+  for (size_t i = 0; i < ind->size(); ++i) tour_[i] = (*ind)[i] - 1;
+  if (!algo_.local_search_->Improve(&tour_)) return;
+  for (size_t i = 0; i < ind->size(); ++i) (*ind)[i] = tour_[i] + 1;
+}
+
+/**
+ * @brief Writes choice genes of head and then the missing genes of tail into
+ * the child in O(n), marking the taken genes
+ *
+ * @param head
+ * @param tail
+ * @param choice Length of the head
+ * @param child Buffer of the size of the ancestors
+ */
+void GeneticAlgorithm::Breeder::Prefix(const Individual &head,
+                                       const Individual &tail, int choice,
+                                       Individual *child) {
+  std::fill(taken_.begin(), taken_.end(), false);
+  size_t next = 0;
+  for (int i = 0; i < choice; ++i) {
+    (*child)[next++] = head[i];
+    taken_[head[i] - 1] = true;
+  }
+  for (int gene : tail) {
+    if (!taken_[gene - 1]) (*child)[next++] = gene;
+  }
+}
+
+/**
+ * @brief Order crossover: the child keeps the genes of the first ancestor in
+ * [left, right] at their places, the rest of the genes go after right in
+ * order of the second ancestor
+ *
+ * @param ancestor1
+ * @param ancestor2
+ * @param left
+ * @param right
+ * @param child Buffer of the size of the ancestors
+ */
+void GeneticAlgorithm::Breeder::Order(const Individual &ancestor1,
+                                      const Individual &ancestor2, int left,
+                                      int right, Individual *child) {
+  const int size = ancestor1.size();
+  std::fill(taken_.begin(), taken_.end(), false);
+  for (int i = left; i <= right; ++i) {
+    (*child)[i] = ancestor1[i];
+    taken_[ancestor1[i] - 1] = true;
+  }
+  int next = (right + 1) % size;
+  for (int i = 0; i < size; ++i) {
+    int gene = ancestor2[(right + 1 + i) % size];
+    if (taken_[gene - 1]) continue;
+    (*child)[next] = gene;
+    next = (next + 1) % size;
+  }
+}
+
+/**
+ * @brief Partially mapped crossover: the child keeps the genes of the first
+ * ancestor in [left, right] at their places and the genes of the second
+ * ancestor elsewhere. A gene already taken is replaced through the mapping of
+ * the segment of the first ancestor onto the second one.
+ *
+ * @param ancestor1
+ * @param ancestor2
+ * @param left
+ * @param right
+ * @param child Buffer of the size of the ancestors
+ */
+void GeneticAlgorithm::Breeder::PartiallyMapped(const Individual &ancestor1,
+                                                const Individual &ancestor2,
+                                                int left, int right,
+                                                Individual *child) {
+  const int size = ancestor1.size();
+  std::fill(taken_.begin(), taken_.end(), false);
+  for (int i = left; i <= right; ++i) {
+    (*child)[i] = ancestor1[i];
+    taken_[ancestor1[i] - 1] = true;
+    position_[ancestor1[i] - 1] = i;
+  }
+  for (int i = 0; i < size; ++i) {
+    if (i == left) i = right + 1;
+    if (i == size) break;
+    int gene = ancestor2[i];
+    while (taken_[gene - 1]) gene = ancestor2[position_[gene - 1]];
+    (*child)[i] = gene;
+  }
+}
+
+/**
+ * @brief Edge assembly crossover: the edges of the first ancestor are
+ * replaced along one random AB-cycle, a closed path taking edges of the
+ * ancestors in turn, by the edges of the second one. The subtours left are
+ * joined smallest first by the cheapest exchange of two edges found through
+ * the candidate lists. Edges are taken as undirected ones.
+ *
+ * @param ancestor1
+ * @param ancestor2
+ * @param random Generator of the pair
+ * @param child Buffer of the size of the ancestors
+ */
+void GeneticAlgorithm::Breeder::EdgeAssembly(const Individual &ancestor1,
+                                             const Individual &ancestor2,
+                                             Random *random,
+                                             Individual *child) {
+  const int size = ancestor1.size();
+  if (size < 4) {
+    std::copy(ancestor1.begin(), ancestor1.end(), child->begin());
+    return;
+  }
+  MakeLinks(ancestor1, &links_a_);
+  MakeLinks(ancestor2, &links_b_);
+  auto has = [](const std::array<int, 2> &links, int vertex) {
+    return links[0] == vertex || links[1] == vertex;
+  };
+  starts_.clear();
+  for (int v = 0; v < size; ++v) {
+    for (int slot : {0, 1}) {
+      free_a_[v][slot] = !has(links_b_[v], links_a_[v][slot]);
+      free_b_[v][slot] = !has(links_a_[v], links_b_[v][slot]);
+    }
+    if (free_a_[v][0] || free_a_[v][1]) starts_.push_back(v);
+  }
+  if (starts_.empty()) {
+    std::copy(ancestor1.begin(), ancestor1.end(), child->begin());
+    return;
+  }
+  links_ = links_a_;
+  ApplyCycle(FindCycle(random));
+  for (int subtours = LabelSubtours(); subtours > 1; --subtours) {
+    int smallest = -1;
+    for (size_t label = 0; label < sizes_.size(); ++label) {
+      if (sizes_[label] > 0 &&
+          (smallest == -1 || sizes_[label] < sizes_[smallest])) {
+        smallest = label;
+      }
+    }
+    MergeSubtour(smallest);
+  }
+  WriteTour(ancestor1, child);
+}
+
+/**
+ * @brief Writes both neighbours of every vertex of the cyclic tour
+ *
+ * @param ind
+ * @param links
+ */
+void GeneticAlgorithm::Breeder::MakeLinks(const Individual &ind,
+                                          Links *links) const {
+  const int size = ind.size();
+  for (int i = 0; i < size; ++i) {
+    (*links)[ind[i] - 1] = {ind[(i + size - 1) % size] - 1,
+                            ind[(i + 1) % size] - 1};
+  }
+}
+
+/**
+ * @brief Walks from a random vertex taking edges of the ancestors in turn,
+ * each edge once, until the walk comes back by an edge of the second ancestor
+ * to a vertex it left by an edge of the first one. Every vertex has as many
+ * unshared edges of one ancestor as of the other, so the walk never gets
+ * stuck.
+ *
+ * @param random
+ * @return size_t Position in path_ where the AB-cycle starts
+ */
+size_t GeneticAlgorithm::Breeder::FindCycle(Random *random) {
+  std::fill(position_.begin(), position_.end(), -1);
+  path_.clear();
+  int vertex = starts_[random->NextInt(0, starts_.size() - 1)];
+  while (position_[vertex] == -1) {
+    position_[vertex] = path_.size();
+    path_.push_back(vertex);
+    int next = TakeEdge(&free_a_, links_a_, vertex, random);
+    path_.push_back(next);
+    vertex = TakeEdge(&free_b_, links_b_, next, random);
+  }
+  return position_[vertex];
+}
+
+/**
+ * @brief Takes a random unused unshared edge of the vertex and returns its
+ * other end
+ *
+ * @param free Unused unshared edges of an ancestor
+ * @param links Edges of the ancestor
+ * @param vertex
+ * @param random
+ * @return int
+ */
+int GeneticAlgorithm::Breeder::TakeEdge(Free *free, const Links &links,
+                                        int vertex, Random *random) const {
+  std::array<bool, 2> &slots = (*free)[vertex];
+  int slot = slots[0] && slots[1] ? random->NextInt(0, 1) : (slots[0] ? 0 : 1);
+  slots[slot] = false;
+  int next = links[vertex][slot];
+  (*free)[next][links[next][0] == vertex ? 0 : 1] = false;
+  return next;
+}
+
+/**
+ * @brief Removes the edges of the first ancestor of the AB-cycle from the
+ * child and adds the edges of the second one, every vertex keeps two edges
+ *
+ * @param start Position in path_ where the AB-cycle starts
+ */
+void GeneticAlgorithm::Breeder::ApplyCycle(size_t start) {
+  for (size_t i = start; i < path_.size(); i += 2) {
+    Unlink(path_[i], path_[i + 1]);
+  }
+  for (size_t i = start + 1; i < path_.size(); i += 2) {
+    Link(path_[i], i + 1 < path_.size() ? path_[i + 1] : path_[start]);
+  }
+}
+
+/**
+ * @brief Labels the vertices of the child by their subtours
+ *
+ * @return int Number of the subtours
+ */
+int GeneticAlgorithm::Breeder::LabelSubtours() {
+  std::fill(label_.begin(), label_.end(), -1);
+  sizes_.clear();
+  heads_.clear();
+  for (size_t v = 0; v < label_.size(); ++v) {
+    if (label_[v] != -1) continue;
+    CollectSubtour(v);
+    for (int u : subtour_) label_[u] = sizes_.size();
+    sizes_.push_back(subtour_.size());
+    heads_.push_back(v);
+  }
+  return sizes_.size();
+}
+
+/**
+ * @brief Joins the subtour with another one replacing an edge of each by two
+ * edges between them at the lowest cost. Candidates are the nearest
+ * neighbours of the subtour, all the vertices if none of them is outside.
+ *
+ * @param label
+ */
+void GeneticAlgorithm::Breeder::MergeSubtour(int label) {
+  CollectSubtour(heads_[label]);
+  long long best = std::numeric_limits<long long>::max();
+  int best_u = -1, best_u2 = -1, best_w = -1, best_w2 = -1;
+  auto consider = [&](int u, int u2, int w) {
+    for (int w2 : links_[w]) {
+      long long removed = Cost(u, u2) + Cost(w, w2);
+      long long straight = Cost(u, w) + Cost(u2, w2) - removed;
+      long long crossed = Cost(u, w2) + Cost(u2, w) - removed;
+      if (straight < best) {
+        best = straight;
+        best_u = u, best_u2 = u2, best_w = w, best_w2 = w2;
+      }
+      if (crossed < best) {
+        best = crossed;
+        best_u = u, best_u2 = u2, best_w = w2, best_w2 = w;
+      }
+    }
+  };
+  const size_t size = subtour_.size();
+  for (size_t i = 0; i < size; ++i) {
+    int u = subtour_[i], u2 = subtour_[(i + 1) % size];
+    for (int w : (*algo_.neighbours_)[u]) {
+      if (label_[w] != label) consider(u, u2, w);
+    }
+  }
+  if (best_u == -1) {
+    for (size_t i = 0; i < size; ++i) {
+      int u = subtour_[i], u2 = subtour_[(i + 1) % size];
+      for (size_t w = 0; w < label_.size(); ++w) {
+        if (label_[w] != label) consider(u, u2, w);
+      }
+    }
+  }
+  int target = label_[best_w];
+  Unlink(best_u, best_u2);
+  Unlink(best_w, best_w2);
+  Link(best_u, best_w);
+  Link(best_u2, best_w2);
+  for (int v : subtour_) label_[v] = target;
+  sizes_[target] += sizes_[label];
+  sizes_[label] = 0;
+}
+
+/**
+ * @brief Writes the vertices of the subtour of the vertex into subtour_ in
+ * order
+ *
+ * @param vertex
+ */
+void GeneticAlgorithm::Breeder::CollectSubtour(int vertex) {
+  subtour_.assign(1, vertex);
+  int previous = vertex;
+  for (int v = links_[vertex][0]; v != vertex;) {
+    subtour_.push_back(v);
+    int next = links_[v][0] == previous ? links_[v][1] : links_[v][0];
+    previous = v;
+    v = next;
+  }
+}
+
+/**
+ * @brief Removes the edge from the child
+ *
+ * @param vertex1
+ * @param vertex2
+ */
+void GeneticAlgorithm::Breeder::Unlink(int vertex1, int vertex2) {
+  links_[vertex1][links_[vertex1][0] == vertex2 ? 0 : 1] = -1;
+  links_[vertex2][links_[vertex2][0] == vertex1 ? 0 : 1] = -1;
+}
+
+/**
+ * @brief Adds the edge to the child in place of a removed one
+ *
+ * @param vertex1
+ * @param vertex2
+ */
+void GeneticAlgorithm::Breeder::Link(int vertex1, int vertex2) {
+  links_[vertex1][links_[vertex1][0] == -1 ? 0 : 1] = vertex2;
+  links_[vertex2][links_[vertex2][0] == -1 ? 0 : 1] = vertex1;
+}
+
+/**
+ * @brief Returns weight of the undirected edge, a prohibitive one if there is
+ * no edge in either direction
+ *
+ * @param vertex1
+ * @param vertex2
+ * @return long long
+ */
+long long GeneticAlgorithm::Breeder::Cost(int vertex1, int vertex2) const {
+  int weight = algo_.graph_[vertex1][vertex2];
+  if (weight == 0) weight = algo_.graph_[vertex2][vertex1];
+  return weight ? weight : std::numeric_limits<int>::max();
+}
+
+/**
+ * @brief Writes the tour of the child as genes, starting where the ancestor
+ * starts and in its direction where possible
+ *
+ * @param ancestor
+ * @param child
+ */
+void GeneticAlgorithm::Breeder::WriteTour(const Individual &ancestor,
+                                          Individual *child) const {
+  int start = ancestor[0] - 1;
+  int previous = start;
+  int v = links_[start][1] == ancestor[1] - 1 ? links_[start][1]
+                                              : links_[start][0];
+  (*child)[0] = start + 1;
+  for (size_t i = 1; i < child->size(); ++i) {
+    (*child)[i] = v + 1;
+    int next = links_[v][0] == previous ? links_[v][1] : links_[v][0];
+    previous = v;
+    v = next;
+  }
+}
+
+/**
+ * @brief Returns length of the genes as a cyclic tour, the last gene leads
+ * back to the first one, or the largest int if an edge is missing
+ *
+ * @param Individual
+ * @return int
+ */
+int GeneticAlgorithm::GetFitness(const Individual &ind) const {
+  if (ind.size() == 0) return -1;
+  int fitness = 0;
+  for (size_t i = 0; i < ind.size(); ++i) {
+    int weight = graph_[ind[i] - 1][ind[(i + 1) % ind.size()] - 1];
+    if (weight == 0) return std::numeric_limits<int>::max();
+    fitness += weight;
+  }
+  return fitness;
 }
 
 /**
- * @brief Returns TsmResult member
+ * @brief Returns the tour of the fittest member as one-based vertices closed
+ * by the first one, vertex 1
  *
  * @return TsmResult
  */
-TsmResult GeneticAlgorithm::GetResult() { return this->result_; }
+TsmResult GeneticAlgorithm::GetResult() {
+  if (result_.vertices.empty()) {
+    throw std::logic_error(
+        "It is impossible to solve the problem with a given graph");
+  }
+  return this->result_;
+}
+
+/**
+ * @brief Returns true if the token of the run is cancelled
+ *
+ * @return true
+ * @return false
+ */
+bool GeneticAlgorithm::IsCancelled() const {
+  return token_ && token_->IsCancelled();
+}
+
+/**
+ * @brief Passes the genes to the callback as a zero-based cyclic tour with
+ * its length if it has no missing edges
+ *
+ * @param ind
+ */
+void GeneticAlgorithm::Report(const Individual &ind) const {
+  if (!callback_) return;
+  LocalSearch::Tour tour(ind.size());
+  for (size_t i = 0; i < ind.size(); ++i) tour[i] = ind[i] - 1;
+  double length = TourConstruction::GetLength(source_, tour);
+  if (length != std::numeric_limits<double>::infinity()) {
+    callback_(TsmResult{tour, length});
+  }
+}
+
+/**
+ * @brief Replaces the least fit member of the island by the tour of the
+ * source if it is fitter than the fittest member
+ *
+ * @param island
+ */
+void GeneticAlgorithm::Import(Island *island) const {
+  TsmResult shared;
+  const int fitness = island->GetBest().fitness;
+  if (!tour_source_ || !tour_source_(fitness, &shared)) return;
+  const size_t size = source_.GetGraph().size();
+  if (!TourConstruction::IsTour(shared.vertices, size)) return;
+  Member immigrant{0, 0, Individual(size)};
+  for (size_t i = 0; i < size; ++i) {
+    immigrant.genes[i] = shared.vertices[i] + 1;
+  }
+  immigrant.fitness = GetFitness(immigrant.genes);
+  if (immigrant.fitness < fitness) island->Accept({immigrant});
+}
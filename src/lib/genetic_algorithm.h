@@ -2,39 +2,199 @@
 #define SRC_LIB_GENETIC_ALGORITHM_H
 
 #include <algorithm>
-#include <map>
+#include <array>
+#include <functional>
+#include <memory>
 #include <random>
 #include <vector>
 
+#include "../misc/cancellation_token.h"
+#include "../misc/thread_pool.h"
 #include "heuristics.h"
+#include "local_search.h"
+#include "neighbour_lists.h"
+#include "random.h"
 #include "s21_graph.h"
 #include "tsmresult.h"
 
+/**
+ * @brief Genetic algorithm for the traveling salesman's problem. Every
+ * population lives in a flat array of preallocated members ordered by an
+ * index array, so generations allocate nothing. Several populations may
+ * evolve as islands exchanging their best members.
+ *
+ */
 class GeneticAlgorithm {
  public:
   using Individual = std::vector<int>;
   using Generation = std::vector<std::vector<int>>;
-  using Population = std::multimap<int, Individual>;
-  using Offspring = std::pair<Individual, Individual>;
 
-  explicit GeneticAlgorithm(const Graph &);
+  /**
+   * @brief Crossovers: the head of one parent and the rest in order of the
+   * other, order crossover (OX), partially mapped crossover (PMX) and edge
+   * assembly crossover (EAX)
+   *
+   */
+  enum class Crossover { kPrefix, kOrder, kPartiallyMapped, kEdgeAssembly };
+
+  /**
+   * @brief Routes of the migrants: to the next island of a ring or to a
+   * random other island
+   *
+   */
+  enum class Topology { kRing, kRandom };
+
+  explicit GeneticAlgorithm(const Graph &, uint64_t seed = Random::MakeSeed());
 
   void RunAlgorithm();
   TsmResult GetResult();
+  void SetCrossover(Crossover crossover);
+  void SetPopulationSize(size_t size);
+  void SetTournamentSize(size_t size);
+  void SetMutationsCount(size_t count);
+  void SetGenerationsCount(size_t generations);
+  void SetThreadsCount(size_t threads);
+  void SetIslandsCount(size_t islands);
+  void SetMigrationInterval(size_t generations);
+  void SetMigrantsCount(size_t count);
+  void SetTopology(Topology topology);
+  void SetLocalSearch(bool enabled);
+  void SetInitialTour(const Individual &tour);
+  void SetCancellationToken(const CancellationToken *token);
+  void SetProgressCallback(TsmCallback callback);
+  void SetTourSource(TsmSource source);
 
  private:
-  Generation MakeGeneration();
-  Offspring Procreate(Individual &, Individual &);
-  void Mutate(Individual *);
+  /**
+   * @brief Individual with its fitness and number of its birth, the older of
+   * equally fit members goes first
+   *
+   */
+  struct Member {
+    int fitness;
+    size_t birth;
+    Individual genes;
+  };
+
+  /**
+   * @brief Crossover with its own buffers, one per thread
+   *
+   */
+  class Breeder {
+   public:
+    explicit Breeder(const GeneticAlgorithm &);
+
+    void Procreate(const Individual &, const Individual &, Random *,
+                   Individual *, Individual *);
+    void Mutate(Individual *, Random *) const;
+    void Polish(Individual *);
+
+   private:
+    using Links = std::vector<std::array<int, 2>>;
+    using Free = std::vector<std::array<bool, 2>>;
+
+    void Prefix(const Individual &head, const Individual &tail, int choice,
+                Individual *child);
+    void Order(const Individual &, const Individual &, int left, int right,
+               Individual *child);
+    void PartiallyMapped(const Individual &, const Individual &, int left,
+                         int right, Individual *child);
+    void EdgeAssembly(const Individual &, const Individual &, Random *,
+                      Individual *child);
+
+    void MakeLinks(const Individual &, Links *) const;
+    size_t FindCycle(Random *);
+    int TakeEdge(Free *, const Links &, int vertex, Random *) const;
+    void ApplyCycle(size_t start);
+    int LabelSubtours();
+    void MergeSubtour(int label);
+    void CollectSubtour(int vertex);
+    void Unlink(int vertex1, int vertex2);
+    void Link(int vertex1, int vertex2);
+    long long Cost(int vertex1, int vertex2) const;
+    void WriteTour(const Individual &, Individual *child) const;
+
+    const GeneticAlgorithm &algo_;
+    std::vector<char> taken_;
+    std::vector<int> position_;
+    Links links_a_;
+    Links links_b_;
+    Links links_;
+    Free free_a_;
+    Free free_b_;
+    std::vector<int> starts_;
+    std::vector<int> path_;
+    std::vector<int> label_;
+    std::vector<int> sizes_;
+    std::vector<int> heads_;
+    std::vector<int> subtour_;
+    LocalSearch::Tour tour_;
+  };
+
+  /**
+   * @brief Population evolving on its own, an island of the algorithm.
+   * Children of an island breed on the pool, one breeder per thread.
+   *
+   */
+  class Island {
+   public:
+    Island(const GeneticAlgorithm &, uint64_t seed, ThreadPool *,
+           size_t breeders);
+
+    void Step();
+    void Emigrate(std::vector<Member> *migrants) const;
+    void Accept(const std::vector<Member> &migrants);
+    const Member &GetBest() const;
+
+   private:
+    void Breed();
+    void Select();
+    size_t Tournament();
+    void ForEach(size_t count,
+                 const std::function<void(size_t, size_t)> &body);
+    int RandomChoice(int, int);
+
+    const GeneticAlgorithm &algo_;
+    ThreadPool *pool_;
+    std::vector<Breeder> breeders_;
+    std::vector<Member> members_;
+    std::vector<size_t> order_;
+    std::vector<size_t> clones_;
+    std::vector<size_t> parents_;
+    Random random_;
+    size_t pairs_;
+    size_t births_ = 0;
+  };
 
-  bool IsGeneInOffspring(const Individual &, int);
-  int GetFitness(const Individual &);
-  int RandomChoice(int, int);
+  void Migrate(std::vector<Island> *islands, Random *random) const;
+  int GetFitness(const Individual &) const;
+  bool IsCancelled() const;
+  void Report(const Individual &) const;
+  void Import(Island *island) const;
 
-  Population population_;
   const Generation &graph_;
+  const Graph &source_;
   const Heuristics consts_;
+  uint64_t seed_;
+  size_t runs_ = 0;
   TsmResult result_;
+  Crossover crossover_ = Crossover::kPrefix;
+  Topology topology_ = Topology::kRing;
+  size_t population_;
+  size_t tournament_ = 0;
+  size_t mutations_;
+  size_t generations_;
+  size_t threads_ = 1;
+  size_t islands_ = 1;
+  size_t migration_;
+  size_t migrants_ = 1;
+  bool polish_ = false;
+  Individual initial_;
+  const CancellationToken *token_ = nullptr;
+  TsmCallback callback_;
+  TsmSource tour_source_;
+  std::unique_ptr<NeighbourLists> neighbours_;
+  std::unique_ptr<LocalSearch> local_search_;
 };
 
 #endif  // SRC_LIB_GENETIC_ALGORITHM_H
@@ -0,0 +1,118 @@
+#include "held_karp_algorithm.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Construct a new Held Karp Algorithm:: Held Karp Algorithm object
+ *
+ * @param graph
+ */
+HeldKarpAlgorithm::HeldKarpAlgorithm(const Graph &graph) : graph_{graph} {}
+
+/**
+ * @brief Fills the table of the shortest paths from vertex 0 through every
+ * set of vertices and restores the shortest tour. Vertex 0 is the start, so
+ * bit v of a set stands for vertex v + 1.
+ *
+ */
+void HeldKarpAlgorithm::RunAlgorithm() {
+  const Graph::Matrix &m = graph_.GetGraph();
+  const int size = m.size();
+  if (static_cast<size_t>(size) > consts_.kHeldKarpSize) {
+    throw std::logic_error("Too many vertices for the Held-Karp algorithm");
+  }
+  result_ = TsmResult();
+  if (size == 1) result_ = TsmResult{{0, 0}, static_cast<double>(m[0][0])};
+  if (size < 2) return;
+  const int k = size - 1;
+  const size_t sets = size_t{1} << k;
+  incoming_.assign(k * k, 0);
+  for (int v = 0; v < k; ++v) {
+    for (int u = 0; u < k; ++u) incoming_[v * k + u] = m[u + 1][v + 1];
+  }
+  cost_.assign(sets * k, kInfinity);
+  for (size_t set = 1; set < sets; ++set) {
+    int *row = &cost_[set * k];
+    for (int v = 0; v < k; ++v) {
+      if (!(set >> v & 1)) continue;
+      size_t previous = set ^ (size_t{1} << v);
+      if (previous == 0) {
+        if (m[0][v + 1] != 0) row[v] = m[0][v + 1];
+        continue;
+      }
+      const int *from = &cost_[previous * k];
+      const int *in = &incoming_[v * k];
+      long long best = kInfinity;
+      for (int u = 0; u < k; ++u) {
+        if (from[u] != kInfinity && in[u] != 0) {
+          best = std::min(best, static_cast<long long>(from[u]) + in[u]);
+        }
+      }
+      row[v] = static_cast<int>(best);
+    }
+  }
+  const int *full = &cost_[(sets - 1) * k];
+  long long best = kInfinity;
+  int last = -1;
+  for (int v = 0; v < k; ++v) {
+    if (full[v] == kInfinity || m[v + 1][0] == 0) continue;
+    if (full[v] + static_cast<long long>(m[v + 1][0]) < best) {
+      best = full[v] + static_cast<long long>(m[v + 1][0]);
+      last = v;
+    }
+  }
+  if (last != -1) {
+    Restore(last);
+    result_.distance = best;
+  }
+  cost_.clear();
+  cost_.shrink_to_fit();
+}
+
+/**
+ * @brief Returns the tour with the contract of
+ * GraphAlgorithms::SolveTravelingSalesmanProblem: one-based vertices closed
+ * by the first one
+ *
+ * @return TsmResult
+ */
+TsmResult HeldKarpAlgorithm::GetResult() const {
+  if (result_.vertices.empty()) {
+    throw std::logic_error(
+        "It is impossible to solve the problem with a given graph");
+  }
+  TsmResult result = result_;
+  for (int &v : result.vertices) ++v;
+  return result;
+}
+
+/**
+ * @brief Restores the tour going back from its last vertex: the previous
+ * vertex is the one whose path gives the cost of the state
+ *
+ * @param last Bit of the last vertex before the return to vertex 0
+ */
+void HeldKarpAlgorithm::Restore(int last) {
+  const int k = graph_.GetGraph().size() - 1;
+  std::vector<int> &tour = result_.vertices;
+  tour.assign(1, 0);
+  size_t set = (size_t{1} << k) - 1;
+  for (int v = last; v != -1;) {
+    tour.push_back(v + 1);
+    size_t previous = set ^ (size_t{1} << v);
+    int next = -1;
+    for (int u = 0; previous != 0 && u < k; ++u) {
+      int from = cost_[previous * k + u], in = incoming_[v * k + u];
+      if (from != kInfinity && in != 0 &&
+          static_cast<long long>(from) + in == cost_[set * k + v]) {
+        next = u;
+        break;
+      }
+    }
+    set = previous;
+    v = next;
+  }
+  tour.push_back(0);
+  std::reverse(tour.begin(), tour.end());
+}
@@ -0,0 +1,38 @@
+#ifndef SRC_LIB_HELD_KARP_ALGORITHM_H
+#define SRC_LIB_HELD_KARP_ALGORITHM_H
+
+#include <limits>
+#include <vector>
+
+#include "heuristics.h"
+#include "s21_graph.h"
+#include "tsmresult.h"
+
+/**
+ * @brief Exact Held-Karp dynamic programming for the traveling salesman's
+ * problem in O(2^n n^2) time and O(2^n n) memory. The state is a bitmask of
+ * the visited vertices and the last vertex; rows of the table are bitmasks,
+ * so a state reads one contiguous row of its predecessors. The tour is
+ * restored from the table, no parents are stored.
+ *
+ */
+class HeldKarpAlgorithm {
+ public:
+  explicit HeldKarpAlgorithm(const Graph &);
+
+  void RunAlgorithm();
+  TsmResult GetResult() const;
+
+ private:
+  static constexpr int kInfinity = std::numeric_limits<int>::max();
+
+  void Restore(int last);
+
+  const Graph &graph_;
+  const Heuristics consts_;
+  std::vector<int> cost_;
+  std::vector<int> incoming_;
+  TsmResult result_;
+};
+
+#endif  // SRC_LIB_HELD_KARP_ALGORITHM_H
@@ -1,6 +1,8 @@
 #ifndef SRC_LIB_HEURISTICS_H
 #define SRC_LIB_HEURISTICS_H
 
+#include <cstddef>
+
 /**
  * @brief Hyperparameters for TSM problem algorithms
  *
@@ -16,10 +18,30 @@ struct Heuristics {
   const double kRo = 0.5;
   const size_t kColonies = 100;
   const size_t kBypassCount = 10;
+  const size_t kNeighbours = 15;
+  const double kMaxMinRo = 0.1;
+  const size_t kStagnation = 100;
+  const size_t kMigration = 50;
+  const double kColonyRo = 0.1;
+  const double kColonyXi = 0.1;
+  const double kGreediness = 0.9;
   const size_t kGenerationsCount = 1000;
   const size_t kGenerationSize = 5;
   const size_t kMutation = 4;
+  const size_t kSeedSwaps = 10;
   const size_t kAttempts = 100;
+  const size_t kReplicas = 8;
+  const double kColdRatio = 0.01;
+  const size_t kMoveDepth = 25;
+  const size_t kMoveBreadth = 3;
+  const size_t kKickLength = 50;
+  const size_t kHeldKarpSize = 20;
+  const size_t kExactSize = 25;
+  const double kExactSeconds = 1.0;
+  const size_t kSubgradientSteps = 100;
+  const size_t kPortfolioPopulation = 30;
+  const size_t kPortfolioTournament = 3;
+  const size_t kPortfolioMutations = 0;
 };
 
 #endif  // SRC_LIB_HEURISTICS_H
@@ -0,0 +1,558 @@
+#include "lin_kernighan_algorithm.h"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <tuple>
+
+#include "tour_construction.h"
+
+/**
+ * @brief Construct a new Lin Kernighan Algorithm:: Lin Kernighan Algorithm
+ * object with kNeighbours candidates per vertex and as many kicks as vertices
+ *
+ * @param graph
+ * @param seed Seed of the random generator, equal seeds give equal results
+ */
+LinKernighanAlgorithm::LinKernighanAlgorithm(const Graph &graph, uint64_t seed)
+    : graph_{graph},
+      seed_{seed},
+      symmetric_{!graph.IsDirected()},
+      neighbours_count_{consts_.kNeighbours},
+      kicks_{graph.GetGraph().size()},
+      random_{seed} {
+  long long largest = 0;
+  for (const auto &row : graph.GetGraph()) {
+    for (int weight : row) largest = std::max<long long>(largest, weight);
+  }
+  missing_ = largest * graph.GetGraph().size() + 1;
+}
+
+/**
+ * @brief Builds a nearest neighbour tour or takes the initial one, improves
+ * it by Lin-Kernighan moves and kicks it until the kicks or the time are
+ * spent. Every run takes a new stream of the seed, so repeated runs give
+ * different tours. A shorter tour of the source replaces the best one
+ * between the kicks.
+ *
+ */
+void LinKernighanAlgorithm::RunAlgorithm() {
+  const int size = graph_.GetGraph().size();
+  result_ = TsmResult();
+  if (size == 0) return;
+  random_ = Random(Random::DeriveRun(seed_, runs_++));
+  neighbours_ = std::make_unique<NeighbourLists>(graph_, neighbours_count_);
+  queued_.assign(size, false);
+  BuildTour();
+  SetPositions();
+  length_ = GetLength();
+  Clock::time_point start = Clock::now();
+  Optimize(tour_);
+  Report();
+  Tour best = tour_;
+  long long best_length = length_;
+  std::vector<int> touched;
+  for (size_t kick = 0; size >= 8 && HasTime(start, kick); ++kick) {
+    Kick(&touched);
+    Optimize(touched);
+    if (length_ < best_length) Report();
+    if (length_ <= best_length) {
+      best = tour_;
+      best_length = length_;
+    } else {
+      tour_ = best;
+      length_ = best_length;
+      SetPositions();
+    }
+    Import(&best, &best_length);
+  }
+  std::rotate(best.begin(), std::find(best.begin(), best.end(), 0),
+              best.end());
+  best.push_back(best.front());
+  for (size_t i = 0; i + 1 < best.size(); ++i) {
+    result_.distance += graph_.GetGraph()[best[i]][best[i + 1]];
+  }
+  result_.vertices = std::move(best);
+  neighbours_.reset();
+}
+
+/**
+ * @brief Returns the tour with the contract of
+ * GraphAlgorithms::SolveTravelingSalesmanProblem: one-based vertices closed
+ * by the first one
+ *
+ * @return TsmResult
+ */
+TsmResult LinKernighanAlgorithm::GetResult() const {
+  const Graph::Matrix &m = graph_.GetGraph();
+  const Tour &tour = result_.vertices;
+  bool complete = !tour.empty();
+  for (size_t i = 0; complete && i + 1 < tour.size(); ++i) {
+    complete = m[tour[i]][tour[i + 1]] != 0;
+  }
+  if (!complete) {
+    throw std::logic_error(
+        "It is impossible to solve the problem with a given graph");
+  }
+  TsmResult result = result_;
+  for (int &v : result.vertices) ++v;
+  return result;
+}
+
+/**
+ * @brief Sets number of candidates per vertex, kNeighbours by default
+ *
+ * @param count
+ */
+void LinKernighanAlgorithm::SetNeighboursCount(size_t count) {
+  neighbours_count_ = std::max<size_t>(1, count);
+}
+
+/**
+ * @brief Sets number of kicks, the number of vertices by default. 0 - no
+ * limit with a time limit, no kicks without it.
+ *
+ * @param kicks
+ */
+void LinKernighanAlgorithm::SetKicksCount(size_t kicks) { kicks_ = kicks; }
+
+/**
+ * @brief Sets wall-clock limit of the kicks, 0 - no limit. The kicks stop at
+ * whichever of the limits comes first.
+ *
+ * @param seconds
+ */
+void LinKernighanAlgorithm::SetTimeLimit(double seconds) {
+  time_limit_ = std::max(0.0, seconds);
+}
+
+/**
+ * @brief Sets the tour the moves start from instead of the nearest neighbour
+ * one, an empty tour brings it back
+ *
+ * @param tour Zero-based permutation of the vertices
+ */
+void LinKernighanAlgorithm::SetInitialTour(const Tour &tour) {
+  if (!tour.empty() &&
+      !TourConstruction::IsTour(tour, graph_.GetGraph().size())) {
+    throw std::logic_error("The initial tour is not a permutation of vertices");
+  }
+  initial_ = tour;
+}
+
+/**
+ * @brief Sets the token stopping the kicks, nullptr - the kicks are not
+ * stopped. A cancelled run returns the best tour found.
+ *
+ * @param token Token outliving the run
+ */
+void LinKernighanAlgorithm::SetCancellationToken(
+    const CancellationToken *token) {
+  token_ = token;
+}
+
+/**
+ * @brief Sets the callback getting the tour after the first descent and
+ * every kicked tour shorter than the best one
+ *
+ * @param callback
+ */
+void LinKernighanAlgorithm::SetProgressCallback(TsmCallback callback) {
+  callback_ = std::move(callback);
+}
+
+/**
+ * @brief Sets the source of shorter tours the next kicks start from, nullptr
+ * - the tours are not shared
+ *
+ * @param source
+ */
+void LinKernighanAlgorithm::SetTourSource(TsmSource source) {
+  tour_source_ = std::move(source);
+}
+
+/**
+ * @brief Takes the initial tour or builds one by going to the nearest
+ * unvisited vertex from a random one. The candidates are tried first, then
+ * all the vertices.
+ *
+ */
+void LinKernighanAlgorithm::BuildTour() {
+  const Graph::Matrix &m = graph_.GetGraph();
+  const int size = m.size();
+  if (!initial_.empty()) {
+    tour_ = initial_;
+    return;
+  }
+  std::vector<char> visited(size, false);
+  tour_.assign(1, random_.NextInt(0, size - 1));
+  visited[tour_.front()] = true;
+  while (static_cast<int>(tour_.size()) < size) {
+    int current = tour_.back(), next = -1;
+    for (int v : (*neighbours_)[current]) {
+      if (!visited[v]) {
+        next = v;
+        break;
+      }
+    }
+    if (next == -1) {
+      for (int v = 0; v < size; ++v) {
+        if (!visited[v] && (next == -1 || Weight(current, v) <
+                                               Weight(current, next))) {
+          next = v;
+        }
+      }
+    }
+    tour_.push_back(next);
+    visited[next] = true;
+  }
+}
+
+/**
+ * @brief Runs the moves from the vertices in a queue. A vertex leaves the
+ * queue when no move starts from it and comes back when a move changes an
+ * edge of it (don't-look bits).
+ *
+ * @param vertices Vertices to start from
+ */
+void LinKernighanAlgorithm::Optimize(const std::vector<int> &vertices) {
+  if (tour_.size() < 4) return;
+  std::deque<int> queue;
+  for (int v : vertices) {
+    if (queued_[v]) continue;
+    queued_[v] = true;
+    queue.push_back(v);
+  }
+  std::vector<int> touched;
+  while (!queue.empty()) {
+    int t1 = queue.front();
+    queue.pop_front();
+    queued_[t1] = false;
+    touched.clear();
+    if (!Improve(t1, &touched)) continue;
+    for (int v : touched) {
+      if (queued_[v]) continue;
+      queued_[v] = true;
+      queue.push_back(v);
+    }
+  }
+}
+
+/**
+ * @brief Applies the first Lin-Kernighan move shortening the tour that
+ * removes an edge (t1, t2) of the vertex. Up to kMoveBreadth first steps
+ * (t3, t4) are tried, best first, the further steps are greedy. Directed
+ * graphs get Or-opt moves.
+ *
+ * @param t1
+ * @param touched Ends of the changed edges
+ * @return true if a move was applied
+ */
+bool LinKernighanAlgorithm::Improve(int t1, std::vector<int> *touched) {
+  if (!symmetric_) return TryOrOpt(t1, touched);
+  Candidates first;
+  for (bool forward : {true, false}) {
+    int t2 = Succ(t1, forward);
+    added_.clear();
+    Choose(t1, t2, Weight(t1, t2), forward, &first);
+    first.resize(std::min(first.size(), consts_.kMoveBreadth));
+    for (const auto &[t3, t4] : first) {
+      if (TryChain(t1, t2, t3, t4, forward, touched)) return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Applies the first Or-opt move shortening the tour that moves a path
+ * of up to three vertices starting at the vertex between c and d, where d is
+ * a near neighbour of the end of the path. The path keeps its direction, its
+ * former neighbours p and q get linked.
+ *
+ * @param a
+ * @param touched Ends of the changed edges
+ * @return true if a move was applied
+ */
+bool LinKernighanAlgorithm::TryOrOpt(int a, std::vector<int> *touched) {
+  const int size = tour_.size();
+  for (int length = 1; length <= 3 && length + 3 <= size; ++length) {
+    int first = a, last = At(position_[a] + length - 1);
+    int p = Prev(first), q = Next(last);
+    long long removed = Weight(p, first) + Weight(last, q) - Weight(p, q);
+    for (int d : (*neighbours_)[last]) {
+      long long added = Weight(last, d);
+      if (added >= removed) break;
+      if (d == q || (position_[d] - position_[first] + size) % size < length) {
+        continue;
+      }
+      int c = Prev(d);
+      added += Weight(c, first) - Weight(c, d);
+      if (added >= removed) continue;
+      int after = (position_[c] - position_[q] + size) % size + 1;
+      if (2 * after <= size - length) {
+        Swap(position_[first], length, after);
+      } else {
+        Swap(position_[d], size - length - after, length);
+      }
+      length_ -= removed - added;
+      touched->insert(touched->end(), {p, q, first, last, c, d});
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Makes a chain of flips: every flip replaces edges (t1, t2) and
+ * (t3, t4) with (t2, t3) and (t1, t4), then t4 becomes t2. The chain goes on
+ * while the added edges cost less than the removed ones and stops at kMoveDepth
+ * flips, the flips after the shortest tour of the chain are undone.
+ *
+ * @param t1 Fixed vertex of the chain
+ * @param t2 Next vertex of t1 in the direction
+ * @param t3 First neighbour of t2
+ * @param t4 Next vertex of t3 in the other direction
+ * @param forward Direction of the tour
+ * @param touched Ends of the changed edges
+ * @return true if the tour was shortened
+ */
+bool LinKernighanAlgorithm::TryChain(int t1, int t2, int t3, int t4,
+                                     bool forward, std::vector<int> *touched) {
+  flips_.clear();
+  added_.clear();
+  chain_.assign(1, t2);
+  long long gain = Weight(t1, t2), best = 0;
+  size_t best_flips = 0;
+  for (size_t depth = 1;; ++depth) {
+    gain += Weight(t3, t4) - Weight(t2, t3);
+    added_.push_back({t2, t3});
+    Flip(t2, t4, forward);
+    chain_.insert(chain_.end(), {t3, t4});
+    t2 = t4;
+    forward = Next(t1) == t2;
+    if (gain - Weight(t2, t1) > best) {
+      best = gain - Weight(t2, t1);
+      best_flips = flips_.size();
+    }
+    if (depth == consts_.kMoveDepth) break;
+    Choose(t1, t2, gain, forward, &candidates_);
+    if (candidates_.empty()) break;
+    std::tie(t3, t4) = candidates_.front();
+  }
+  Undo(best_flips);
+  if (best <= 0) return false;
+  length_ -= best;
+  touched->push_back(t1);
+  touched->insert(touched->end(), chain_.begin(),
+                  chain_.begin() + 2 * best_flips + 1);
+  return true;
+}
+
+/**
+ * @brief Collects the next steps of the chain: near neighbours t3 of t2
+ * keeping the gain positive, an edge (t3, t4) added by the chain is not
+ * removed again. The steps go by the gain of the step, best first.
+ *
+ * @param t1
+ * @param t2
+ * @param gain Removed length minus added length of the chain
+ * @param forward Direction of the tour
+ * @param candidates
+ */
+void LinKernighanAlgorithm::Choose(int t1, int t2, long long gain,
+                                   bool forward, Candidates *candidates) const {
+  candidates->clear();
+  for (int t3 : (*neighbours_)[t2]) {
+    if (gain - Weight(t2, t3) <= 0) break;
+    int t4 = Succ(t3, !forward);
+    if (t3 == t1 || t4 == t2) continue;
+    bool tabu = std::any_of(added_.begin(), added_.end(), [=](auto edge) {
+      return (edge.first == t3 && edge.second == t4) ||
+             (edge.first == t4 && edge.second == t3);
+    });
+    if (!tabu) candidates->push_back({t3, t4});
+  }
+  std::stable_sort(candidates->begin(), candidates->end(),
+                   [this, t2](auto x, auto y) {
+                     return Weight(x.first, x.second) - Weight(t2, x.first) >
+                            Weight(y.first, y.second) - Weight(t2, y.first);
+                   });
+}
+
+/**
+ * @brief Swaps two adjacent random paths of up to kKickLength vertices, a
+ * double-bridge move changing only a part of the tour. Directions of the
+ * paths stay, so the kick suits directed graphs as well.
+ *
+ * @param touched Ends of the changed edges
+ */
+void LinKernighanAlgorithm::Kick(std::vector<int> *touched) {
+  const int size = tour_.size();
+  int longest = std::min<int>(consts_.kKickLength, (size - 2) / 2);
+  int first = random_.NextInt(0, size - 1);
+  int length1 = random_.NextInt(1, longest);
+  int length2 = random_.NextInt(1, longest);
+  int a = At(first - 1), b1 = At(first), b2 = At(first + length1 - 1);
+  int c1 = At(first + length1), c2 = At(first + length1 + length2 - 1);
+  int d = At(first + length1 + length2);
+  length_ += Weight(a, c1) + Weight(c2, b1) + Weight(b2, d) - Weight(a, b1) -
+             Weight(b2, c1) - Weight(c2, d);
+  Swap(first, length1, length2);
+  touched->assign({a, b1, b2, c1, c2, d});
+}
+
+/**
+ * @brief Returns true while the kicks may go on: neither the kicks nor the
+ * time are spent and the run is not cancelled
+ *
+ * @param start
+ * @param kicks Number of the kicks made
+ */
+bool LinKernighanAlgorithm::HasTime(Clock::time_point start,
+                                    size_t kicks) const {
+  if (token_ && token_->IsCancelled()) return false;
+  if (kicks_ > 0 && kicks >= kicks_) return false;
+  if (time_limit_ <= 0.0) return kicks_ > 0;
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  return elapsed.count() < time_limit_;
+}
+
+/**
+ * @brief Reverses the path from t2 to t4 in the direction, or the rest of the
+ * cycle if it is shorter, and remembers the flip
+ *
+ * @param t2
+ * @param t4
+ * @param forward Direction of the tour
+ */
+void LinKernighanAlgorithm::Flip(int t2, int t4, bool forward) {
+  const int size = tour_.size();
+  int from = forward ? t2 : t4, to = forward ? t4 : t2;
+  int index = position_[from];
+  int length = (position_[to] - index + size) % size + 1;
+  if (2 * length > size) {
+    index += length;
+    length = size - length;
+  }
+  Reverse(index, length);
+  flips_.push_back({index, length});
+}
+
+/**
+ * @brief Reverses the path of the length starting at the index of the array
+ *
+ * @param index
+ * @param length
+ */
+void LinKernighanAlgorithm::Reverse(int index, int length) {
+  const int size = tour_.size();
+  for (int i = index, j = index + length - 1; i < j; ++i, --j) {
+    int u = At(i), v = At(j);
+    tour_[(i % size + size) % size] = v;
+    tour_[(j % size + size) % size] = u;
+    position_[v] = (i % size + size) % size;
+    position_[u] = (j % size + size) % size;
+  }
+}
+
+/**
+ * @brief Swaps the adjacent paths of the lengths starting at the index of the
+ * array by three reversals, the paths keep their directions
+ *
+ * @param index
+ * @param length1
+ * @param length2
+ */
+void LinKernighanAlgorithm::Swap(int index, int length1, int length2) {
+  Reverse(index, length1 + length2);
+  Reverse(index, length2);
+  Reverse(index + length2, length1);
+}
+
+/**
+ * @brief Undoes the last flips leaving the given number of them
+ *
+ * @param flips
+ */
+void LinKernighanAlgorithm::Undo(size_t flips) {
+  while (flips_.size() > flips) {
+    Reverse(flips_.back().first, flips_.back().second);
+    flips_.pop_back();
+  }
+}
+
+void LinKernighanAlgorithm::SetPositions() {
+  position_.resize(tour_.size());
+  for (size_t i = 0; i < tour_.size(); ++i) position_[tour_[i]] = i;
+}
+
+int LinKernighanAlgorithm::At(int index) const {
+  const int size = tour_.size();
+  return tour_[(index % size + size) % size];
+}
+
+int LinKernighanAlgorithm::Next(int vertex) const {
+  return At(position_[vertex] + 1);
+}
+
+int LinKernighanAlgorithm::Prev(int vertex) const {
+  return At(position_[vertex] - 1);
+}
+
+int LinKernighanAlgorithm::Succ(int vertex, bool forward) const {
+  return forward ? Next(vertex) : Prev(vertex);
+}
+
+/**
+ * @brief Returns weight of the edge, missing edges cost more than any tour
+ *
+ * @param from
+ * @param to
+ * @return long long
+ */
+long long LinKernighanAlgorithm::Weight(int from, int to) const {
+  int weight = graph_.GetGraph()[from][to];
+  return weight != 0 ? weight : missing_;
+}
+
+/**
+ * @brief Passes the current tour to the callback if it has no missing edges
+ *
+ */
+void LinKernighanAlgorithm::Report() const {
+  if (callback_ && length_ < missing_) {
+    callback_(TsmResult{tour_, static_cast<double>(length_)});
+  }
+}
+
+/**
+ * @brief Takes the tour of the source as the best one if it is shorter, the
+ * current tour is the best one on return
+ *
+ * @param best
+ * @param best_length
+ */
+void LinKernighanAlgorithm::Import(Tour *best, long long *best_length) {
+  TsmResult shared;
+  if (!tour_source_ || !tour_source_(*best_length, &shared)) return;
+  if (!TourConstruction::IsTour(shared.vertices, tour_.size())) return;
+  tour_ = std::move(shared.vertices);
+  SetPositions();
+  length_ = GetLength();
+  if (length_ < *best_length) {
+    *best = tour_;
+    *best_length = length_;
+  } else {
+    tour_ = *best;
+    length_ = *best_length;
+    SetPositions();
+  }
+}
+
+long long LinKernighanAlgorithm::GetLength() const {
+  long long length = 0;
+  for (size_t i = 0; i < tour_.size(); ++i) {
+    length += Weight(tour_[i], tour_[(i + 1) % tour_.size()]);
+  }
+  return length;
+}
@@ -0,0 +1,97 @@
+#ifndef SRC_LIB_LIN_KERNIGHAN_ALGORITHM_H
+#define SRC_LIB_LIN_KERNIGHAN_ALGORITHM_H
+
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../misc/cancellation_token.h"
+#include "heuristics.h"
+#include "neighbour_lists.h"
+#include "random.h"
+#include "s21_graph.h"
+#include "tsmresult.h"
+
+/**
+ * @brief Iterated Lin-Kernighan algorithm for the traveling salesman's
+ * problem. A tour improves by chains of 2-opt flips with a fixed first vertex
+ * (Lin-Kernighan moves) looked for among the nearest neighbours, then gets
+ * random local double-bridge kicks, a kicked tour is kept if it is no longer
+ * after the moves. Flips reverse paths, so directed graphs improve by Or-opt
+ * moves instead. Missing edges cost more than any tour of existing edges, so
+ * the moves take them out of the tour whenever they can.
+ *
+ */
+class LinKernighanAlgorithm {
+ public:
+  using Tour = std::vector<int>;
+
+  explicit LinKernighanAlgorithm(const Graph &,
+                                 uint64_t seed = Random::MakeSeed());
+
+  void RunAlgorithm();
+  TsmResult GetResult() const;
+  void SetNeighboursCount(size_t count);
+  void SetKicksCount(size_t kicks);
+  void SetTimeLimit(double seconds);
+  void SetInitialTour(const Tour &tour);
+  void SetCancellationToken(const CancellationToken *token);
+  void SetProgressCallback(TsmCallback callback);
+  void SetTourSource(TsmSource source);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  using Candidates = std::vector<std::pair<int, int>>;
+
+  void BuildTour();
+  void Optimize(const std::vector<int> &vertices);
+  bool Improve(int t1, std::vector<int> *touched);
+  bool TryOrOpt(int a, std::vector<int> *touched);
+  bool TryChain(int t1, int t2, int t3, int t4, bool forward,
+                std::vector<int> *touched);
+  void Choose(int t1, int t2, long long gain, bool forward,
+              Candidates *candidates) const;
+  void Kick(std::vector<int> *touched);
+  bool HasTime(Clock::time_point start, size_t kicks) const;
+  void Report() const;
+  void Import(Tour *best, long long *best_length);
+  void Flip(int t2, int t4, bool forward);
+  void Reverse(int index, int length);
+  void Swap(int index, int length1, int length2);
+  void Undo(size_t flips);
+  void SetPositions();
+  int At(int index) const;
+  int Next(int vertex) const;
+  int Prev(int vertex) const;
+  int Succ(int vertex, bool forward) const;
+  long long Weight(int from, int to) const;
+  long long GetLength() const;
+
+  const Graph &graph_;
+  const Heuristics consts_;
+  uint64_t seed_;
+  size_t runs_ = 0;
+  bool symmetric_;
+  size_t neighbours_count_;
+  size_t kicks_;
+  double time_limit_ = 0.0;
+  Tour initial_;
+  const CancellationToken *token_ = nullptr;
+  TsmCallback callback_;
+  TsmSource tour_source_;
+  long long missing_;
+  std::unique_ptr<NeighbourLists> neighbours_;
+  Random random_;
+  Tour tour_;
+  std::vector<int> position_;
+  std::vector<char> queued_;
+  std::vector<std::pair<int, int>> flips_;
+  std::vector<std::pair<int, int>> added_;
+  std::vector<int> chain_;
+  Candidates candidates_;
+  long long length_ = 0;
+  TsmResult result_;
+};
+
+#endif  // SRC_LIB_LIN_KERNIGHAN_ALGORITHM_H
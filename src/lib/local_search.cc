@@ -0,0 +1,327 @@
+#include "local_search.h"
+
+#include <algorithm>
+#include <deque>
+
+/**
+ * @brief Construct a new Local Search:: Local Search object with kNeighbours
+ * candidates per vertex
+ *
+ * @param graph
+ */
+LocalSearch::LocalSearch(const Graph &graph)
+    : LocalSearch(graph, Heuristics().kNeighbours) {}
+
+/**
+ * @brief Construct a new Local Search:: Local Search object
+ *
+ * @param graph
+ * @param neighbours Number of candidates per vertex
+ */
+LocalSearch::LocalSearch(const Graph &graph, size_t neighbours)
+    : graph_{graph},
+      symmetric_{!graph.IsDirected()},
+      neighbours_{graph, neighbours} {}
+
+/**
+ * @brief Improves the tour by 2-opt moves until none of them shortens it:
+ * edges (a, b) and (c, d) are replaced with (a, c) and (b, d) by reversing
+ * the path from b to c, c is a near neighbour of a. A reversed path costs the
+ * same only on symmetric graphs, so directed graphs are left as they are.
+ *
+ * @param tour
+ * @return true if the tour was shortened
+ */
+bool LocalSearch::TwoOpt(Tour *tour) const {
+  return Optimize(tour, true, false);
+}
+
+/**
+ * @brief Improves the tour by Or-opt moves until none of them shortens it: a
+ * path of up to three vertices moves next to a near neighbour of its end. On
+ * directed graphs paths keep their direction.
+ *
+ * @param tour
+ * @return true if the tour was shortened
+ */
+bool LocalSearch::OrOpt(Tour *tour) const {
+  return Optimize(tour, false, true);
+}
+
+/**
+ * @brief Improves the tour by 2-opt and Or-opt moves until none of them
+ * shortens it. 2-opt runs alone first: early Or-opt moves on a random tour
+ * lead to worse local optima.
+ *
+ * @param tour
+ * @return true if the tour was shortened
+ */
+bool LocalSearch::Improve(Tour *tour) const {
+  bool improved = Optimize(tour, true, false);
+  return Optimize(tour, true, true) || improved;
+}
+
+/**
+ * @brief Improves the zero-based tour of a solver, closed by its first vertex
+ * or not, and updates its distance. Incomplete tours are left as they are.
+ *
+ * @param result
+ * @return true if the tour was shortened
+ */
+bool LocalSearch::Polish(TsmResult *result) const {
+  Tour tour = result->vertices;
+  bool closed = tour.size() > 1 && tour.front() == tour.back();
+  if (closed) tour.pop_back();
+  if (tour.size() != graph_.GetGraph().size()) return false;
+  if (!Improve(&tour)) return false;
+  result->distance = GetLength(tour);
+  if (closed) tour.push_back(tour.front());
+  result->vertices = std::move(tour);
+  return true;
+}
+
+/**
+ * @brief Returns length of the closed tour
+ *
+ * @param tour
+ * @return double
+ */
+double LocalSearch::GetLength(const Tour &tour) const {
+  double length = 0.0;
+  for (size_t i = 0; i < tour.size(); ++i) {
+    length += Weight(tour[i], tour[(i + 1) % tour.size()]);
+  }
+  return length;
+}
+
+/**
+ * @brief Runs the moves from every vertex in a queue. A vertex leaves the
+ * queue when no move starts from it and comes back when a move changes an
+ * edge of it. A move may also open up at a vertex whose edges stay, so the
+ * queue is refilled with all the vertices until a round finds nothing.
+ *
+ * @param tour
+ * @param two_opt Look for 2-opt moves
+ * @param or_opt Look for Or-opt moves
+ * @return true if the tour was shortened
+ */
+bool LocalSearch::Optimize(Tour *tour, bool two_opt, bool or_opt) const {
+  const int size = tour->size();
+  two_opt = two_opt && symmetric_;
+  if (size < 4 || (!two_opt && !or_opt)) return false;
+  Array array(tour);
+  std::deque<int> queue;
+  std::vector<char> queued(size, false);
+  std::vector<int> touched;
+  bool improved = false, round = true;
+  while (round) {
+    round = false;
+    for (int v : *tour) queue.push_back(v);
+    std::fill(queued.begin(), queued.end(), true);
+    while (!queue.empty()) {
+      int a = queue.front();
+      queue.pop_front();
+      queued[a] = false;
+      touched.clear();
+      if ((two_opt && TryTwoOpt(&array, a, &touched)) ||
+          (or_opt && TryOrOpt(&array, a, &touched))) {
+        improved = round = true;
+        touched.push_back(a);
+        for (int v : touched) {
+          if (queued[v]) continue;
+          queued[v] = true;
+          queue.push_back(v);
+        }
+      }
+    }
+  }
+  return improved;
+}
+
+/**
+ * @brief Applies the first 2-opt move shortening the tour that replaces an
+ * edge of the vertex with an edge to its near neighbour
+ *
+ * @param array
+ * @param a
+ * @param touched Ends of the changed edges
+ * @return true if a move was applied
+ */
+bool LocalSearch::TryTwoOpt(Array *array, int a,
+                            std::vector<int> *touched) const {
+  for (bool forward : {true, false}) {
+    int b = forward ? array->Next(a) : array->Prev(a);
+    int ab = Weight(a, b);
+    for (int c : neighbours_[a]) {
+      int ac = Weight(a, c);
+      if (ac >= ab) break;
+      int d = forward ? array->Next(c) : array->Prev(c);
+      if (c == b || d == a) continue;
+      int bd = Weight(b, d);
+      if (bd == 0 || ac + bd >= ab + Weight(c, d)) continue;
+      if (forward) {
+        array->Reverse(b, c);
+      } else {
+        array->Reverse(a, d);
+      }
+      touched->insert(touched->end(), {b, c, d});
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Applies the first Or-opt move shortening the tour that moves a path
+ * of up to three vertices starting or ending at the vertex next to a near
+ * neighbour of it. The path goes between c and d, reversed if needed, its
+ * former neighbours p and q get linked.
+ *
+ * @param array
+ * @param a
+ * @param touched Ends of the changed edges
+ * @return true if a move was applied
+ */
+bool LocalSearch::TryOrOpt(Array *array, int a,
+                           std::vector<int> *touched) const {
+  const int size = graph_.GetGraph().size();
+  for (int length = 1; length <= 3 && length + 3 <= size; ++length) {
+    for (bool starts : {true, false}) {
+      if (!symmetric_ && starts) continue;
+      int first = a, last = a;
+      for (int i = 1; i < length; ++i) {
+        if (starts) {
+          last = array->Next(last);
+        } else {
+          first = array->Prev(first);
+        }
+      }
+      int p = array->Prev(first), q = array->Next(last);
+      int pq = Weight(p, q);
+      if (pq == 0) continue;
+      int removed = Weight(p, first) + Weight(last, q) - pq;
+      for (int x : neighbours_[a]) {
+        int ax = Weight(a, x);
+        if (ax >= removed) break;
+        if (array->Contains(first, length, x)) continue;
+        for (bool after : {true, false}) {
+          if (!symmetric_ && after) continue;
+          int c = after ? x : array->Prev(x);
+          int d = after ? array->Next(x) : x;
+          if (array->Contains(first, length, after ? d : c)) continue;
+          bool reversed = after != starts;
+          int other = after ? Weight(reversed ? first : last, d)
+                            : Weight(c, reversed ? last : first);
+          if (other == 0 || ax + other - Weight(c, d) >= removed) continue;
+          array->Move(first, length, c, reversed);
+          touched->insert(touched->end(), {p, q, first, last, c, d});
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+int LocalSearch::Weight(int from, int to) const {
+  return graph_.GetGraph()[from][to];
+}
+
+/**
+ * @brief Construct a new Local Search:: Array:: Array object over the tour
+ *
+ * @param tour
+ */
+LocalSearch::Array::Array(Tour *tour)
+    : tour_{*tour}, position_(tour->size()) {
+  for (size_t i = 0; i < tour_.size(); ++i) position_[tour_[i]] = i;
+}
+
+int LocalSearch::Array::Next(int vertex) const {
+  return At(position_[vertex] + 1);
+}
+
+int LocalSearch::Array::Prev(int vertex) const {
+  return At(position_[vertex] - 1);
+}
+
+/**
+ * @brief Returns true if the vertex is on the path of the length starting at
+ * first
+ *
+ * @param first
+ * @param length
+ * @param vertex
+ * @return true
+ * @return false
+ */
+bool LocalSearch::Array::Contains(int first, int length, int vertex) const {
+  const int size = tour_.size();
+  return (position_[vertex] - position_[first] + size) % size < length;
+}
+
+/**
+ * @brief Reverses the path from the vertex to the vertex, or the rest of the
+ * cycle if it is shorter, which gives the same tour in the other direction
+ *
+ * @param from
+ * @param to
+ */
+void LocalSearch::Array::Reverse(int from, int to) {
+  const int size = tour_.size();
+  int i = position_[from], j = position_[to];
+  int length = (j - i + size) % size + 1;
+  if (2 * length > size) {
+    std::swap(i, j);
+    ++i, --j;
+    length = size - length;
+  }
+  for (; length > 1; length -= 2, ++i, --j) {
+    int u = At(i), v = At(j);
+    Set(i, v);
+    Set(j, u);
+  }
+}
+
+/**
+ * @brief Moves the path of the length starting at first between the vertex
+ * after and the next one, shifting the shorter side of the cycle
+ *
+ * @param first
+ * @param length Up to three vertices
+ * @param after Vertex off the path
+ * @param reversed Put the path in the other direction
+ */
+void LocalSearch::Array::Move(int first, int length, int after,
+                              bool reversed) {
+  const int size = tour_.size();
+  int start = position_[first];
+  int segment[3];
+  for (int k = 0; k < length; ++k) segment[k] = At(start + k);
+  if (reversed) std::reverse(segment, segment + length);
+  int between = (position_[after] - start - length + 1 + 2 * size) % size;
+  int rest = size - length - between;
+  if (between <= rest) {
+    for (int k = 0; k < between; ++k) Set(start + k, At(start + length + k));
+    for (int k = 0; k < length; ++k) Set(start + between + k, segment[k]);
+  } else {
+    for (int k = rest - 1; k >= 0; --k) {
+      Set(start + 2 * length + between + k, At(start + length + between + k));
+    }
+    for (int k = 0; k < length; ++k) {
+      Set(start + length + between + k, segment[k]);
+    }
+  }
+}
+
+int LocalSearch::Array::At(int index) const {
+  const int size = tour_.size();
+  return tour_[(index % size + size) % size];
+}
+
+void LocalSearch::Array::Set(int index, int vertex) {
+  const int size = tour_.size();
+  index = (index % size + size) % size;
+  tour_[index] = vertex;
+  position_[vertex] = index;
+}
@@ -0,0 +1,67 @@
+#ifndef SRC_LIB_LOCAL_SEARCH_H
+#define SRC_LIB_LOCAL_SEARCH_H
+
+#include <vector>
+
+#include "heuristics.h"
+#include "neighbour_lists.h"
+#include "s21_graph.h"
+#include "tsmresult.h"
+
+/**
+ * @brief Local improvement of the tours of the TSM solvers. A tour is a
+ * zero-based cyclic permutation of the vertices, the closing vertex is not
+ * repeated. Missing edges are never put into a tour. Moves are looked for
+ * among the nearest neighbours of the vertices, vertices whose neighbourhood
+ * did not change are not looked at again (don't-look bits).
+ *
+ */
+class LocalSearch {
+ public:
+  using Tour = std::vector<int>;
+
+  explicit LocalSearch(const Graph &);
+  LocalSearch(const Graph &, size_t neighbours);
+
+  bool TwoOpt(Tour *tour) const;
+  bool OrOpt(Tour *tour) const;
+  bool Improve(Tour *tour) const;
+  bool Polish(TsmResult *result) const;
+  double GetLength(const Tour &tour) const;
+
+ private:
+  /**
+   * @brief Tour in an array with the positions of its vertices. A path is
+   * reversed on the shorter side of the cycle and a segment is moved by
+   * shifting the shorter side, so the moves take O(n / 2) at most.
+   *
+   */
+  class Array {
+   public:
+    explicit Array(Tour *tour);
+
+    int Next(int vertex) const;
+    int Prev(int vertex) const;
+    bool Contains(int first, int length, int vertex) const;
+    void Reverse(int from, int to);
+    void Move(int first, int length, int after, bool reversed);
+
+   private:
+    int At(int index) const;
+    void Set(int index, int vertex);
+
+    Tour &tour_;
+    std::vector<int> position_;
+  };
+
+  bool Optimize(Tour *tour, bool two_opt, bool or_opt) const;
+  bool TryTwoOpt(Array *array, int a, std::vector<int> *touched) const;
+  bool TryOrOpt(Array *array, int a, std::vector<int> *touched) const;
+  int Weight(int from, int to) const;
+
+  const Graph &graph_;
+  bool symmetric_;
+  NeighbourLists neighbours_;
+};
+
+#endif  // SRC_LIB_LOCAL_SEARCH_H
@@ -0,0 +1,36 @@
+#ifndef SRC_LIB_MSTRESULT_H
+#define SRC_LIB_MSTRESULT_H
+
+#include <vector>
+
+/**
+ * @brief Struct for minimal spanning tree storage as a list of edges with
+ * zero-based vertices
+ *
+ */
+struct MstResult {
+  struct Edge {
+    int from;
+    int to;
+    int weight;
+  };
+
+  std::vector<Edge> edges;
+  long long weight = 0;
+  size_t size = 0;
+
+  /**
+   * @brief Returns the tree as an adjacency matrix of size x size
+   *
+   * @return std::vector<std::vector<int>>
+   */
+  std::vector<std::vector<int>> ToMatrix() const {
+    std::vector<std::vector<int>> matrix(size, std::vector<int>(size));
+    for (const Edge &edge : edges) {
+      matrix[edge.from][edge.to] = matrix[edge.to][edge.from] = edge.weight;
+    }
+    return matrix;
+  }
+};
+
+#endif  // SRC_LIB_MSTRESULT_H
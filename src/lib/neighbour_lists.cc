@@ -0,0 +1,46 @@
+#include "neighbour_lists.h"
+
+#include <algorithm>
+
+/**
+ * @brief Construct a new Neighbour Lists:: Neighbour Lists object. Loops and
+ * missing edges are not candidates, ties are broken by the vertex index.
+ *
+ * @param graph
+ * @param count Length of a list, k
+ */
+NeighbourLists::NeighbourLists(const Graph &graph, size_t count)
+    : count_{count} {
+  const Graph::Matrix &m = graph.GetGraph();
+  lists_.resize(m.size());
+  for (size_t i = 0; i < m.size(); ++i) {
+    List &list = lists_[i];
+    for (size_t j = 0; j < m.size(); ++j) {
+      if (i != j && m[i][j] != 0) list.push_back(j);
+    }
+    auto nearer = [&m, i](int x, int y) {
+      return m[i][x] != m[i][y] ? m[i][x] < m[i][y] : x < y;
+    };
+    size_t size = std::min(count, list.size());
+    std::partial_sort(list.begin(), list.begin() + size, list.end(), nearer);
+    list.resize(size);
+    list.shrink_to_fit();
+  }
+}
+
+/**
+ * @brief Returns the candidates of the vertex, nearest first
+ *
+ * @param vertex Zero-based vertex
+ * @return const NeighbourLists::List&
+ */
+const NeighbourLists::List &NeighbourLists::operator[](size_t vertex) const {
+  return lists_[vertex];
+}
+
+/**
+ * @brief Returns the largest length of a list, k
+ *
+ * @return size_t
+ */
+size_t NeighbourLists::GetCount() const { return count_; }
@@ -0,0 +1,28 @@
+#ifndef SRC_LIB_NEIGHBOUR_LISTS_H
+#define SRC_LIB_NEIGHBOUR_LISTS_H
+
+#include <vector>
+
+#include "s21_graph.h"
+
+/**
+ * @brief Candidate lists of the TSM solvers: for every vertex up to k
+ * vertices reachable by its cheapest outgoing edges, nearest first. Built
+ * once per graph in O(n^2 log k).
+ *
+ */
+class NeighbourLists {
+ public:
+  using List = std::vector<int>;
+
+  NeighbourLists(const Graph &, size_t count);
+
+  const List &operator[](size_t vertex) const;
+  size_t GetCount() const;
+
+ private:
+  std::vector<List> lists_;
+  size_t count_;
+};
+
+#endif  // SRC_LIB_NEIGHBOUR_LISTS_H
@@ -0,0 +1,366 @@
+#include "portfolio_solver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "../misc/thread_pool.h"
+#include "annealing_algorithm.h"
+#include "ant_algorithm.h"
+#include "branch_and_bound_algorithm.h"
+#include "genetic_algorithm.h"
+#include "lin_kernighan_algorithm.h"
+#include "tour_construction.h"
+
+/**
+ * @brief Construct a new Portfolio Solver:: Portfolio Solver object
+ *
+ * @param graph
+ * @param seed Seed of the random generator, engines get independent streams
+ */
+PortfolioSolver::PortfolioSolver(const Graph &graph, uint64_t seed)
+    : graph_{graph}, seed_{seed} {}
+
+/**
+ * @brief Runs the engines, each on a thread of its own, until all of them
+ * finish, the time is spent or the target is reached, and cancels the rest.
+ * Graphs of less than 4 vertices have one tour, which the branch and bound
+ * engine alone finds by default. Every run takes a new stream of the seed.
+ *
+ */
+void PortfolioSolver::RunAlgorithm() {
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point deadline =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double>(time_limit_));
+  const size_t size = graph_.GetGraph().size();
+  best_ = TsmResult{{}, std::numeric_limits<double>::infinity()};
+  bound_ = 0.0;
+  winner_ = Engine::kBranchAndBound;
+  token_ = std::make_unique<CancellationToken>();
+  if (size == 0) return;
+  std::vector<Engine> engines = engines_;
+  if (engines.empty() && size >= 4) {
+    engines = {Engine::kAnt, Engine::kAnnealing, Engine::kGenetic,
+               Engine::kLinKernighan};
+  }
+  if (engines_.empty() && size <= consts_.kExactSize) {
+    engines.push_back(Engine::kBranchAndBound);
+  }
+  const bool exact = std::find(engines.begin(), engines.end(),
+                               Engine::kBranchAndBound) != engines.end();
+  const bool bound = !exact && target_gap_ > 0.0;
+  const std::vector<int> initial = TourConstruction(graph_).GreedyEdge();
+  running_ = engines.size() + bound;
+  ThreadPool pool(running_);
+  auto task = [this](const std::function<void()> &body) {
+    try {
+      body();
+    } catch (...) {
+      token_->Cancel();
+      Finish();
+      throw;
+    }
+    Finish();
+  };
+  const uint64_t run = Random::DeriveRun(seed_, runs_++);
+  std::vector<std::future<void>> results;
+  for (size_t i = 0; i < engines.size(); ++i) {
+    uint64_t seed = Random::Derive(run, i);
+    results.push_back(pool.Submit([this, &task, &engines, &initial, i, seed] {
+      task([this, &engines, &initial, i, seed] {
+        if (engines[i] == Engine::kBranchAndBound) {
+          RunBound(true);
+        } else {
+          Run(engines[i], seed, initial);
+        }
+      });
+    }));
+  }
+  if (bound) {
+    results.push_back(pool.Submit([this, &task] {
+      task([this] { RunBound(false); });
+    }));
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto done = [this] { return running_ == 0 || token_->IsCancelled(); };
+    if (time_limit_ > 0.0) {
+      finished_.wait_until(lock, deadline, done);
+    } else {
+      finished_.wait(lock, done);
+    }
+  }
+  token_->Cancel();
+  for (auto &result : results) result.wait();
+  for (auto &result : results) result.get();
+}
+
+/**
+ * @brief Returns the best tour with the contract of
+ * GraphAlgorithms::SolveTravelingSalesmanProblem: one-based vertices closed
+ * by the first one
+ *
+ * @return TsmResult
+ */
+TsmResult PortfolioSolver::GetResult() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (best_.vertices.empty()) {
+    throw std::logic_error(
+        "It is impossible to solve the problem with a given graph");
+  }
+  TsmResult result = best_;
+  std::vector<int> &tour = result.vertices;
+  std::rotate(tour.begin(), std::find(tour.begin(), tour.end(), 0),
+              tour.end());
+  tour.push_back(0);
+  for (int &v : tour) ++v;
+  return result;
+}
+
+/**
+ * @brief Sets the engines, the default ones are ant colony, annealing,
+ * genetic and Lin-Kernighan, and branch and bound for graphs of up to
+ * kExactSize vertices. Branch and bound without a time limit runs until the
+ * search ends, which takes exponential time.
+ *
+ * @param engines
+ */
+void PortfolioSolver::SetEngines(const std::vector<Engine> &engines) {
+  engines_ = engines;
+  std::sort(engines_.begin(), engines_.end());
+  engines_.erase(std::unique(engines_.begin(), engines_.end()),
+                 engines_.end());
+}
+
+/**
+ * @brief Sets the deadline of the run, 0 - the engines run their own
+ * budgets. Engines without a time budget run until the deadline.
+ *
+ * @param seconds
+ */
+void PortfolioSolver::SetTimeLimit(double seconds) {
+  time_limit_ = std::max(0.0, seconds);
+}
+
+/**
+ * @brief Sets the length of a good enough tour, 0 - none
+ *
+ * @param length
+ */
+void PortfolioSolver::SetTargetLength(double length) {
+  target_length_ = std::max(0.0, length);
+}
+
+/**
+ * @brief Sets the share of the lower bound a tour may exceed it by to be good
+ * enough, 0 - only a tour of the length of the bound, which is optimal
+ *
+ * @param gap
+ */
+void PortfolioSolver::SetTargetGap(double gap) {
+  target_gap_ = std::max(0.0, gap);
+}
+
+/**
+ * @brief Sets the callback getting every new best tour of the portfolio, it
+ * is called from the threads of the engines one at a time
+ *
+ * @param callback
+ */
+void PortfolioSolver::SetProgressCallback(TsmCallback callback) {
+  callback_ = std::move(callback);
+}
+
+/**
+ * @brief Returns the lower bound of the tours of the last run, 0 - unknown,
+ * infinity - there is no tour. Equals the length of the tour if branch and
+ * bound has proven it optimal.
+ *
+ * @return double
+ */
+double PortfolioSolver::GetLowerBound() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bound_;
+}
+
+/**
+ * @brief Returns the engine that has found the best tour
+ *
+ * @return PortfolioSolver::Engine
+ */
+PortfolioSolver::Engine PortfolioSolver::GetWinner() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return winner_;
+}
+
+/**
+ * @brief Runs a metaheuristic on one thread from the initial tour. Ant colony
+ * and genetic algorithm have no time budget, so with a deadline they run
+ * until they are cancelled. Annealing cools a single chain, which has no
+ * point to take the best tour of the portfolio up at.
+ *
+ * @param engine
+ * @param seed
+ * @param initial Zero-based initial tour
+ */
+void PortfolioSolver::Run(Engine engine, uint64_t seed,
+                          const std::vector<int> &initial) {
+  const bool endless = time_limit_ > 0.0;
+  const size_t forever = std::numeric_limits<size_t>::max() / 2;
+  TsmCallback offer = [this, engine](const TsmResult &result) {
+    Offer(engine, result);
+  };
+  TsmSource share = [this](double length, TsmResult *shorter) {
+    return Share(length, shorter);
+  };
+  if (engine == Engine::kAnt) {
+    AntAlgorithm algo(graph_, seed);
+    algo.SetThreadsCount(1);
+    algo.SetIslandsCount(1);
+    algo.SetMode(AntAlgorithm::Mode::kMaxMin);
+    algo.SetLocalSearch(true);
+    if (endless) algo.SetIterationsCount(forever);
+    algo.SetInitialTour(initial);
+    algo.SetCancellationToken(token_.get());
+    algo.SetProgressCallback(offer);
+    algo.SetTourSource(share);
+    algo.RunAlgorithm();
+  } else if (engine == Engine::kAnnealing) {
+    AnnealingAlgorithm algo(graph_, seed);
+    algo.SetThreadsCount(1);
+    algo.SetTimeBudget(time_limit_);
+    algo.SetLocalSearch(true);
+    algo.SetInitialTour(initial);
+    algo.SetCancellationToken(token_.get());
+    algo.SetProgressCallback(offer);
+    algo.RunAlgorithm();
+  } else if (engine == Engine::kGenetic) {
+    GeneticAlgorithm algo(graph_, seed);
+    algo.SetCrossover(GeneticAlgorithm::Crossover::kEdgeAssembly);
+    algo.SetPopulationSize(consts_.kPortfolioPopulation);
+    algo.SetTournamentSize(consts_.kPortfolioTournament);
+    algo.SetMutationsCount(consts_.kPortfolioMutations);
+    algo.SetLocalSearch(true);
+    if (endless) algo.SetGenerationsCount(forever);
+    algo.SetInitialTour(initial);
+    algo.SetCancellationToken(token_.get());
+    algo.SetProgressCallback(offer);
+    algo.SetTourSource(share);
+    algo.RunAlgorithm();
+  } else if (engine == Engine::kLinKernighan) {
+    LinKernighanAlgorithm algo(graph_, seed);
+    if (endless) {
+      algo.SetKicksCount(0);
+      algo.SetTimeLimit(time_limit_);
+    }
+    algo.SetInitialTour(initial);
+    algo.SetCancellationToken(token_.get());
+    algo.SetProgressCallback(offer);
+    algo.SetTourSource(share);
+    algo.RunAlgorithm();
+  }
+}
+
+/**
+ * @brief Finds the lower bound by branch and bound and, for the engine, goes
+ * on with the search. A finished search proves its tour optimal, or that
+ * there is no tour, so the bound rises to the length of the tour.
+ *
+ * @param search True for the engine, false for the bound alone
+ */
+void PortfolioSolver::RunBound(bool search) {
+  BranchAndBoundAlgorithm algo(graph_);
+  algo.SetTimeLimit(time_limit_);
+  algo.SetCancellationToken(token_.get());
+  if (search) {
+    algo.SetProgressCallback([this](const TsmResult &result) {
+      Offer(Engine::kBranchAndBound, result);
+    });
+  }
+  SetBound(algo.FindLowerBound());
+  if (!search) return;
+  algo.RunAlgorithm();
+  if (!algo.IsOptimal()) return;
+  try {
+    SetBound(algo.GetResult().distance);
+  } catch (const std::logic_error &) {
+    SetBound(std::numeric_limits<double>::infinity());
+  }
+}
+
+/**
+ * @brief Takes the tour of the engine if it is the best one and cancels the
+ * engines once the target is reached
+ *
+ * @param engine
+ * @param result Zero-based cyclic tour and its length
+ */
+void PortfolioSolver::Offer(Engine engine, const TsmResult &result) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (result.distance >= best_.distance) return;
+  best_ = result;
+  winner_ = engine;
+  if (callback_) callback_(best_);
+  if (IsReached()) {
+    token_->Cancel();
+    finished_.notify_all();
+  }
+}
+
+/**
+ * @brief Copies the best tour if it is shorter than the length
+ *
+ * @param length
+ * @param shorter Zero-based cyclic tour and its length
+ * @return true if the tour is copied
+ * @return false
+ */
+bool PortfolioSolver::Share(double length, TsmResult *shorter) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (best_.distance >= length) return false;
+  *shorter = best_;
+  return true;
+}
+
+/**
+ * @brief Raises the lower bound and cancels the engines once the target is
+ * reached
+ *
+ * @param bound
+ */
+void PortfolioSolver::SetBound(double bound) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bound_ = std::max(bound_, bound);
+  if (IsReached()) {
+    token_->Cancel();
+    finished_.notify_all();
+  }
+}
+
+/**
+ * @brief Returns true if the best tour is good enough or there is no tour,
+ * the caller holds the lock
+ *
+ * @return true
+ * @return false
+ */
+bool PortfolioSolver::IsReached() const {
+  const double infinity = std::numeric_limits<double>::infinity();
+  if (bound_ == infinity) return true;
+  if (best_.distance == infinity) return false;
+  return best_.distance <= target_length_ ||
+         (bound_ > 0.0 && best_.distance <= bound_ * (1.0 + target_gap_));
+}
+
+/**
+ * @brief Counts a finished task off and wakes the run up
+ *
+ */
+void PortfolioSolver::Finish() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  --running_;
+  finished_.notify_all();
+}
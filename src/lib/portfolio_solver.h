@@ -0,0 +1,80 @@
+#ifndef SRC_LIB_PORTFOLIO_SOLVER_H
+#define SRC_LIB_PORTFOLIO_SOLVER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../misc/cancellation_token.h"
+#include "heuristics.h"
+#include "random.h"
+#include "s21_graph.h"
+#include "tsmresult.h"
+
+/**
+ * @brief Portfolio of TSM solvers running concurrently under one deadline,
+ * one thread per engine. The engines start from a shared greedy edge tour
+ * and publish their new best tours, the portfolio keeps the best one and
+ * cancels all the engines once it reaches the target length or is within
+ * the target gap of the lower bound. Ant colony, genetic algorithm and
+ * Lin-Kernighan pick the best tour up as a migrant, an immigrant and a
+ * restart tour while they run. The bound comes from the branch and
+ * bound engine, or from its root alone if the engine is not in the
+ * portfolio and a gap is set.
+ *
+ */
+class PortfolioSolver {
+ public:
+  /**
+   * @brief Solvers of the portfolio
+   *
+   */
+  enum class Engine {
+    kAnt,
+    kAnnealing,
+    kGenetic,
+    kLinKernighan,
+    kBranchAndBound
+  };
+
+  explicit PortfolioSolver(const Graph &, uint64_t seed = Random::MakeSeed());
+
+  void RunAlgorithm();
+  TsmResult GetResult() const;
+  void SetEngines(const std::vector<Engine> &engines);
+  void SetTimeLimit(double seconds);
+  void SetTargetLength(double length);
+  void SetTargetGap(double gap);
+  void SetProgressCallback(TsmCallback callback);
+  double GetLowerBound() const;
+  Engine GetWinner() const;
+
+ private:
+  void Run(Engine engine, uint64_t seed, const std::vector<int> &initial);
+  void RunBound(bool search);
+  void Offer(Engine engine, const TsmResult &result);
+  bool Share(double length, TsmResult *shorter) const;
+  void SetBound(double bound);
+  bool IsReached() const;
+  void Finish();
+
+  const Graph &graph_;
+  const Heuristics consts_;
+  uint64_t seed_;
+  size_t runs_ = 0;
+  std::vector<Engine> engines_;
+  double time_limit_ = 0.0;
+  double target_length_ = 0.0;
+  double target_gap_ = 0.0;
+  TsmCallback callback_;
+  std::unique_ptr<CancellationToken> token_;
+  mutable std::mutex mutex_;
+  std::condition_variable finished_;
+  size_t running_ = 0;
+  TsmResult best_;
+  double bound_ = 0.0;
+  Engine winner_ = Engine::kLinKernighan;
+};
+
+#endif  // SRC_LIB_PORTFOLIO_SOLVER_H
@@ -0,0 +1,124 @@
+#ifndef SRC_LIB_RANDOM_H
+#define SRC_LIB_RANDOM_H
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+
+/**
+ * @brief Fast xoshiro256++ pseudo-random generator. Equal seeds give equal
+ * sequences on every platform, so the solvers are reproducible with a fixed
+ * seed. Not thread-safe, every thread needs its own generator.
+ *
+ */
+class Random {
+ public:
+  using result_type = uint64_t;
+
+  explicit Random(uint64_t seed = MakeSeed()) {
+    for (auto &state : state_) state = SplitMix(&seed);
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    uint64_t result = Rotate(state_[0] + state_[3], 23) + state_[0];
+    uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = Rotate(state_[3], 45);
+    return result;
+  }
+
+  /**
+   * @brief Returns random double number from range [0, 1)
+   *
+   */
+  double NextDouble() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+  /**
+   * @brief Returns random double number from range [min, max)
+   *
+   */
+  double NextDouble(double min, double max) {
+    return min + (max - min) * NextDouble();
+  }
+
+  /**
+   * @brief Returns random integer number from range [min, max]
+   *
+   */
+  int NextInt(int min, int max) {
+    uint64_t range =
+        static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    uint64_t limit = Random::max() - Random::max() % range;
+    uint64_t x;
+    do {
+      x = (*this)();
+    } while (x >= limit);
+    return static_cast<int>(min + static_cast<int64_t>(x % range));
+  }
+
+  /**
+   * @brief Randomly permutes the range by the Fisher-Yates shuffle
+   *
+   */
+  template <class Iterator>
+  void Shuffle(Iterator first, Iterator last) {
+    for (auto i = last - first - 1; i > 0; --i) {
+      std::swap(first[i], first[NextInt(0, i)]);
+    }
+  }
+
+  /**
+   * @brief Returns seed of an independent stream derived from the seed, for
+   * generators of worker threads
+   *
+   */
+  static uint64_t Derive(uint64_t seed, uint64_t stream) {
+    seed ^= stream * 0x9e3779b97f4a7c15ULL;
+    return SplitMix(&seed);
+  }
+
+  /**
+   * @brief Returns seed of a run of a solver, the seed itself for the first
+   * run and an independent stream for every next one, so repeated runs give
+   * different tours in a reproducible order
+   *
+   */
+  static uint64_t DeriveRun(uint64_t seed, uint64_t run) {
+    return run == 0 ? seed : Derive(~seed, run);
+  }
+
+  /**
+   * @brief Returns nondeterministic seed
+   *
+   */
+  static uint64_t MakeSeed() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+  }
+
+ private:
+  static uint64_t Rotate(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  static uint64_t SplitMix(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t state_[4];
+};
+
+#endif  // SRC_LIB_RANDOM_H
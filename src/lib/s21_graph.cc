@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+std::atomic<size_t> Graph::versions_{0};
+
 /**
  * @brief Loading a graph from a file in the adjacency matrix format
  *
@@ -120,6 +122,7 @@ void Graph::SaveUndirected(std::ofstream& file) const {
  */
 void Graph::CreateGraph(const int& size) {
   this->graph_ = Matrix(size, std::vector<int>(size));
+  this->version_ = ++versions_;
 }
 
 /**
@@ -142,3 +145,28 @@ int Graph::GetWeight(int idx1, int idx2) const {
     throw std::out_of_range("Graph index out of range");
   return graph_[idx1][idx2];
 }
+
+/**
+ * @brief Sets weight at (vertex1, vertex2) coordinate, 0 removes the edge.
+ * The graph gets a new version.
+ *
+ * @param vertex1
+ * @param vertex2
+ * @param weight
+ */
+void Graph::SetWeight(int idx1, int idx2, int weight) {
+  if ((idx1 < 0 or idx1 >= static_cast<int>(graph_.size())) or
+      (idx2 < 0 or idx2 >= static_cast<int>(graph_.size())))
+    throw std::out_of_range("Graph index out of range");
+  if (weight < 0) throw std::logic_error("Negative edge weight");
+  graph_[idx1][idx2] = weight;
+  version_ = ++versions_;
+}
+
+/**
+ * @brief Returns version of the graph. Every change of the graph gets a new
+ * version unique among all graphs, so cached results can be keyed by it
+ *
+ * @return size_t
+ */
+size_t Graph::GetVersion() const { return this->version_; }
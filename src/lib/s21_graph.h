@@ -2,6 +2,7 @@
 #define SRC_LIB_S21_GRAPH_H
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -16,10 +17,15 @@ class Graph {
 
   const Matrix& GetGraph() const;
   int GetWeight(int vertex1, int vertex2) const;
+  void SetWeight(int vertex1, int vertex2, int weight);
   bool IsDirected() const;
+  size_t GetVersion() const;
 
  private:
   Matrix graph_;
+  size_t version_ = 0;
+
+  static std::atomic<size_t> versions_;
 
   void SaveDirected(std::ofstream& file) const;
   void SaveUndirected(std::ofstream& file) const;
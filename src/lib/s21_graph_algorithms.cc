@@ -86,34 +86,91 @@ int GraphAlgorithms::GetShortestPathBetweenVertices(const Graph& graph,
       !GraphAlgorithms::IsCorrectVertex(vertex2, graph)) {
     throw std::logic_error("The index for vertex incorrect!");
   }
-  vertex1 -= 1;
-  vertex2 -= 1;
-  const int kInfinity = std::numeric_limits<int>::max();
-  std::vector<int> min_distance(graph.GetGraph().size(), kInfinity);
-  min_distance[vertex1] = 0;
-
-  std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
-                      std::greater<std::pair<int, int>>>
-      dist_to_vertex;
-  dist_to_vertex.push(std::make_pair(min_distance[vertex1], vertex1));
-
-  while (!dist_to_vertex.empty()) {
-    int curr_ver = dist_to_vertex.top().second;
-    dist_to_vertex.pop();
-
-    if (curr_ver == vertex2) return min_distance[vertex2];
+  Vector min_distance = Dijkstra(graph, vertex1 - 1, {vertex2 - 1});
+  return min_distance[vertex2 - 1];
+}
 
-    for (std::size_t v = 0; v < graph.GetGraph().size(); ++v) {
-      int edge_weight = graph.GetGraph()[curr_ver][v];
+/**
+ * @brief Dijkstra's algorithm from one vertex to all others. The result can be
+ * reused for any number of queries with the same starting vertex.
+ *
+ * @param graph Adjacency matrix
+ * @param vertex The starting vertex from which the search begins
+ * @return GraphAlgorithms::Vector The distances to every vertex, -1 for
+ * unreachable ones
+ */
+GraphAlgorithms::Vector GraphAlgorithms::GetShortestPathsFromVertex(
+    const Graph& graph, int vertex) {
+  if (!GraphAlgorithms::IsCorrectVertex(vertex, graph)) {
+    throw std::logic_error("The index for vertex incorrect!");
+  }
+  return Dijkstra(graph, vertex - 1, {});
+}
 
-      if (edge_weight != 0 &&
-          min_distance[curr_ver] + edge_weight < min_distance[v]) {
-        min_distance[v] = min_distance[curr_ver] + edge_weight;
-        dist_to_vertex.push(std::make_pair(min_distance[v], v));
-      }
+/**
+ * @brief Shortest distances for a batch of (source, target) pairs. Pairs are
+ * grouped by source, each distinct source gets one Dijkstra search which stops
+ * once all targets of the group are settled. Groups are spread across threads.
+ *
+ * @param graph Adjacency matrix
+ * @param pairs The (source, target) vertices
+ * @param threads Number of threads, 0 - number of hardware threads
+ * @return GraphAlgorithms::Vector The distance for every pair in the order of
+ * pairs, -1 for unreachable targets
+ */
+GraphAlgorithms::Vector GraphAlgorithms::GetShortestPathsBetweenPairs(
+    const Graph& graph, const Pairs& pairs, size_t threads) {
+  std::map<int, std::vector<size_t>> groups;
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    if (!GraphAlgorithms::IsCorrectVertex(pairs[i].first, graph) ||
+        !GraphAlgorithms::IsCorrectVertex(pairs[i].second, graph)) {
+      throw std::logic_error("The index for vertex incorrect!");
+    }
+    groups[pairs[i].first - 1].push_back(i);
+  }
+  std::vector<std::pair<int, std::vector<size_t>>> tasks(groups.begin(),
+                                                         groups.end());
+  Vector result(pairs.size());
+  auto search = [&](size_t task, size_t) {
+    const auto& [source, indices] = tasks[task];
+    Vector targets;
+    for (size_t idx : indices) targets.push_back(pairs[idx].second - 1);
+    Vector min_distance = Dijkstra(graph, source, targets);
+    for (size_t idx : indices) {
+      result[idx] = min_distance[pairs[idx].second - 1];
     }
+  };
+  if (threads == 1 || tasks.size() < 2) {
+    for (size_t i = 0; i < tasks.size(); ++i) search(i, 0);
+  } else {
+    ThreadPool pool(std::min(threads ? threads
+                                     : ThreadPool::DefaultThreadsCount(),
+                             tasks.size()));
+    pool.ParallelFor(tasks.size(), search);
   }
-  return -1;
+  return result;
+}
+
+/**
+ * @brief Delta-stepping is a parallel variant of Dijkstra's algorithm: vertices
+ * are kept in buckets of distances of width delta and all vertices of the
+ * current bucket are relaxed at once across threads.
+ *
+ * @param graph Adjacency matrix
+ * @param vertex The starting vertex from which the search begins
+ * @param threads Number of threads, 0 - number of hardware threads
+ * @return GraphAlgorithms::Vector The distances to every vertex, -1 for
+ * unreachable ones
+ */
+GraphAlgorithms::Vector GraphAlgorithms::GetShortestPathsDeltaStepping(
+    const Graph& graph, int vertex, size_t threads) {
+  if (!GraphAlgorithms::IsCorrectVertex(vertex, graph)) {
+    throw std::logic_error("The index for vertex incorrect!");
+  }
+  DeltaStepping algo(graph);
+  algo.SetThreadsCount(threads);
+  algo.RunAlgorithm(vertex - 1);
+  return algo.GetResult();
 }
 
 /**
@@ -163,55 +220,182 @@ GraphAlgorithms::Matrix GraphAlgorithms::GetShortestPathsBetweenAllVertices(
  * algorithm that finds a minimum spanning tree for a weighted undirected graph.
  * This means it finds a subset of the edges that forms a tree that includes
  * every vertex, where the total weight of all the edges in the tree is
- * minimized.
+ * minimized. The array variant is used for dense graphs and the heap variant
+ * for sparse ones.
  * @param graph Adjacency matrix
  * @return GraphAlgorithms::Matrix The adjacency matrix for the minimal spanning
  * tree
  */
 GraphAlgorithms::Matrix GraphAlgorithms::GetLeastSpanningTree(
     const Graph& graph) {
-  if (graph.IsDirected()) {
-    throw std::logic_error("Algoritm deal with undirected graphs only");
+  return GetLeastSpanningTreeEdges(graph).ToMatrix();
+}
+
+/**
+ * @brief Prim's algorithm as in GetLeastSpanningTree, but the tree is returned
+ * as a list of V - 1 edges instead of a V x V matrix.
+ * @param graph Adjacency matrix
+ * @return MstResult The edges and total weight of the minimal spanning tree
+ */
+MstResult GraphAlgorithms::GetLeastSpanningTreeEdges(const Graph& graph) {
+  CheckSpanningTreeGraph(graph);
+  const Matrix& m = graph.GetGraph();
+  double edges = 0;
+  for (size_t i = 0; i < m.size(); ++i) {
+    for (size_t j = i + 1; j < m.size(); ++j) {
+      if (m[i][j] != 0) ++edges;
+    }
   }
-  if (graph.GetGraph().size() < 2) {
-    throw std::logic_error("The size of graph is less than necessary");
+  double size = m.size();
+  if (edges * std::log2(size) < size * size) {
+    return SpanningTree(graph, PrimSparse(graph), false);
   }
-  std::vector<bool> span(graph.GetGraph().size());
-  span[0] = true;
-  int span_cnt = graph.GetGraph().size() - 1;
-  Matrix res = Matrix(graph.GetGraph().size(),
-                      std::vector<int>(graph.GetGraph().size()));
-  while (span_cnt > 0) {
-    int min_weigth = std::numeric_limits<int>::max(), i_min = 0, j_min = 0;
-    for (size_t i = 0; i < graph.GetGraph().size(); ++i) {
-      if (span[i]) {
-        for (size_t j = 0; j < graph.GetGraph().size(); ++j) {
-          if (!span[j] && graph.GetGraph()[i][j] != 0) {
-            if (min_weigth > graph.GetGraph()[i][j]) {
-              min_weigth = graph.GetGraph()[i][j];
-              i_min = i;
-              j_min = j;
-            }
-          }
-        }
+  return SpanningTree(graph, PrimDense(graph), false);
+}
+
+/**
+ * @brief Prim's algorithm for dense graphs in O(V^2): keeps for every vertex
+ * outside the tree the lightest edge into the tree and picks the least of
+ * them on every step.
+ * @param graph Adjacency matrix
+ * @return MstResult The edges and total weight of the minimal spanning tree
+ */
+MstResult GraphAlgorithms::GetLeastSpanningTreeDense(const Graph& graph) {
+  CheckSpanningTreeGraph(graph);
+  return SpanningTree(graph, PrimDense(graph), false);
+}
+
+/**
+ * @brief Prim's algorithm for sparse graphs in O(E log V) over adjacency
+ * lists and a binary heap of candidate edges. Building the lists from the
+ * adjacency matrix is O(V^2) on its own.
+ * @param graph Adjacency matrix
+ * @return MstResult The edges and total weight of the minimal spanning tree
+ */
+MstResult GraphAlgorithms::GetLeastSpanningTreeSparse(const Graph& graph) {
+  CheckSpanningTreeGraph(graph);
+  return SpanningTree(graph, PrimSparse(graph), false);
+}
+
+/**
+ * @brief Array variant of Prim's algorithm
+ *
+ * @param graph
+ * @return GraphAlgorithms::Edges The edges of the tree spanning vertex 1
+ */
+GraphAlgorithms::Edges GraphAlgorithms::PrimDense(const Graph& graph) {
+  const Matrix& m = graph.GetGraph();
+  const int kInfinity = std::numeric_limits<int>::max();
+  std::vector<bool> span(m.size());
+  Vector key(m.size(), kInfinity), parent(m.size(), -1);
+  key[0] = 0;
+  for (size_t step = 0; step < m.size(); ++step) {
+    int next = -1;
+    for (size_t v = 0; v < m.size(); ++v) {
+      if (!span[v] && key[v] != kInfinity &&
+          (next == -1 || key[v] < key[next])) {
+        next = v;
+      }
+    }
+    if (next == -1) break;
+    span[next] = true;
+    for (size_t v = 0; v < m.size(); ++v) {
+      if (!span[v] && m[next][v] != 0 && m[next][v] < key[v]) {
+        key[v] = m[next][v];
+        parent[v] = next;
       }
     }
-    res[i_min][j_min] = res[j_min][i_min] = min_weigth;
-    --span_cnt;
-    span[j_min] = true;
   }
-  return res;
+  return ParentEdges(graph, parent);
+}
+
+/**
+ * @brief Heap variant of Prim's algorithm
+ *
+ * @param graph
+ * @return GraphAlgorithms::Edges The edges of the tree spanning vertex 1
+ */
+GraphAlgorithms::Edges GraphAlgorithms::PrimSparse(const Graph& graph) {
+  const Matrix& m = graph.GetGraph();
+  std::vector<Vector> adjacency(m.size());
+  for (size_t i = 0; i < m.size(); ++i) {
+    for (size_t j = 0; j < m.size(); ++j) {
+      if (i != j && m[i][j] != 0) adjacency[i].push_back(j);
+    }
+  }
+  std::vector<bool> span(m.size());
+  Vector parent(m.size(), -1);
+  using Candidate = std::pair<int, std::pair<int, int>>;
+  std::priority_queue<Candidate, std::vector<Candidate>,
+                      std::greater<Candidate>>
+      candidates;
+  candidates.push({0, {-1, 0}});
+  while (!candidates.empty()) {
+    auto [from, to] = candidates.top().second;
+    candidates.pop();
+    if (span[to]) continue;
+    span[to] = true;
+    parent[to] = from;
+    for (int v : adjacency[to]) {
+      if (!span[v]) candidates.push({m[to][v], {to, v}});
+    }
+  }
+  return ParentEdges(graph, parent);
+}
+
+/**
+ * @brief Kruskal's algorithm finds a minimum spanning tree by adding edges in
+ * increasing order of weight unless they close a cycle. Suits sparse graphs,
+ * the edges are sorted in parallel.
+ * @param graph Adjacency matrix
+ * @param threads Number of threads, 0 - number of hardware threads
+ * @return MstResult The edges and total weight of the minimal spanning tree
+ */
+MstResult GraphAlgorithms::GetLeastSpanningTreeKruskal(const Graph& graph,
+                                                       size_t threads) {
+  CheckSpanningTreeGraph(graph);
+  return SpanningTree(graph, Kruskal(graph, threads), false);
+}
+
+/**
+ * @brief Borůvka's algorithm finds a minimum spanning tree in O(log V) rounds,
+ * each joining every component with its cheapest outgoing edge. The cheapest
+ * edges are searched in parallel.
+ * @param graph Adjacency matrix
+ * @param threads Number of threads, 0 - number of hardware threads
+ * @return MstResult The edges and total weight of the minimal spanning tree
+ */
+MstResult GraphAlgorithms::GetLeastSpanningTreeBoruvka(const Graph& graph,
+                                                       size_t threads) {
+  CheckSpanningTreeGraph(graph);
+  return SpanningTree(graph, Boruvka(graph, threads), false);
+}
+
+/**
+ * @brief Minimum spanning forest, a minimum spanning tree for every connected
+ * component of the graph. Unlike GetLeastSpanningTree, accepts disconnected
+ * graphs.
+ * @param graph Adjacency matrix
+ * @return MstResult The edges and total weight of the minimal spanning
+ * forest
+ */
+MstResult GraphAlgorithms::GetLeastSpanningForest(const Graph& graph) {
+  CheckSpanningTreeGraph(graph);
+  return SpanningTree(graph, Kruskal(graph, 0), true);
 }
 
 /**
  * @brief Solves the traveling salesman's problem on loaded graph using the ant
- * colony algorithm.
+ * colony algorithm. Graphs of up to kExactSize vertices are solved exactly.
  *
  * @param graph
+ * @param seed Seed of the random generator, equal seeds give equal results
  * @return TsmResult
  */
-TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(const Graph& graph) {
-  AntAlgorithm algo(graph);
+TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(const Graph& graph,
+                                                         uint64_t seed) {
+  if (IsSmallTsm(graph)) return SolveSmallTsm(graph);
+  AntAlgorithm algo(graph, seed);
   algo.RunAlgorithm();
   return algo.GetResult();
 }
@@ -221,10 +405,12 @@ TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(const Graph& graph) {
  * simulated annealing algorithm.
  *
  * @param graph
+ * @param seed Seed of the random generator, equal seeds give equal results
  * @return TsmResult
  */
-TsmResult GraphAlgorithms::SolveTsmSimulatedAnnealing(const Graph& graph) {
-  AnnealingAlgorithm algo(graph);
+TsmResult GraphAlgorithms::SolveTsmSimulatedAnnealing(const Graph& graph,
+                                                      uint64_t seed) {
+  AnnealingAlgorithm algo(graph, seed);
   algo.RunAlgorithm();
   return algo.GetResult();
 }
@@ -234,14 +420,325 @@ TsmResult GraphAlgorithms::SolveTsmSimulatedAnnealing(const Graph& graph) {
  * genetic algorithm.
  *
  * @param graph
+ * @param seed Seed of the random generator, equal seeds give equal results
+ * @return TsmResult
+ */
+TsmResult GraphAlgorithms::SolveTsmGenetic(const Graph& graph, uint64_t seed) {
+  GeneticAlgorithm algo(graph, seed);
+  algo.RunAlgorithm();
+  return algo.GetResult();
+}
+
+/**
+ * @brief Solves the traveling salesman's problem on loaded graph using the
+ * iterated Lin-Kernighan algorithm.
+ *
+ * @param graph
+ * @param seconds Time limit of the kicks, 0 - as many kicks as vertices
+ * @param seed Seed of the random generator, equal seeds give equal results
+ * without a time limit
+ * @return TsmResult
+ */
+TsmResult GraphAlgorithms::SolveTsmLinKernighan(const Graph& graph,
+                                                double seconds,
+                                                uint64_t seed) {
+  LinKernighanAlgorithm algo(graph, seed);
+  if (seconds > 0.0) {
+    algo.SetKicksCount(0);
+    algo.SetTimeLimit(seconds);
+  }
+  algo.RunAlgorithm();
+  return algo.GetResult();
+}
+
+/**
+ * @brief Solves the traveling salesman's problem on loaded graph exactly by
+ * the Held-Karp dynamic programming, for up to kHeldKarpSize vertices.
+ *
+ * @param graph
  * @return TsmResult
  */
-TsmResult GraphAlgorithms::SolveTsmGenetic(const Graph& graph) {
-  GeneticAlgorithm algo(graph);
+TsmResult GraphAlgorithms::SolveTsmHeldKarp(const Graph& graph) {
+  HeldKarpAlgorithm algo(graph);
   algo.RunAlgorithm();
   return algo.GetResult();
 }
 
+/**
+ * @brief Solves the traveling salesman's problem on loaded graph exactly by
+ * branch and bound. The time grows exponentially with the size of the graph.
+ *
+ * @param graph
+ * @param seconds Time limit of the search, 0 - no limit. A stopped search
+ * returns the shortest tour found.
+ * @return TsmResult
+ */
+TsmResult GraphAlgorithms::SolveTsmBranchAndBound(const Graph& graph,
+                                                  double seconds) {
+  BranchAndBoundAlgorithm algo(graph);
+  algo.SetTimeLimit(seconds);
+  algo.RunAlgorithm();
+  return algo.GetResult();
+}
+
+/**
+ * @brief Solves the traveling salesman's problem on loaded graph by a
+ * portfolio of the solvers running concurrently, each on a thread of its own.
+ * The run stops once branch and bound proves the best tour optimal.
+ *
+ * @param graph
+ * @param seconds Time limit of the run, 0 - the solvers run their own
+ * budgets
+ * @param seed
+ * @return TsmResult
+ */
+TsmResult GraphAlgorithms::SolveTsmPortfolio(const Graph& graph,
+                                             double seconds, uint64_t seed) {
+  PortfolioSolver algo(graph, seed);
+  algo.SetTimeLimit(seconds);
+  algo.RunAlgorithm();
+  return algo.GetResult();
+}
+
+/**
+ * @brief Returns true if the graph is small enough for the exact solvers,
+ * which are faster than the metaheuristics there
+ *
+ * @param graph
+ */
+bool GraphAlgorithms::IsSmallTsm(const Graph& graph) {
+  return graph.GetGraph().size() <= Heuristics().kExactSize;
+}
+
+/**
+ * @brief Solves a small graph by branch and bound within kExactSeconds. A
+ * search stopped by the time falls back to the Held-Karp algorithm if the
+ * graph has up to kHeldKarpSize vertices, otherwise its best tour is taken.
+ *
+ * @param graph
+ * @return TsmResult
+ */
+TsmResult GraphAlgorithms::SolveSmallTsm(const Graph& graph) {
+  const Heuristics consts;
+  BranchAndBoundAlgorithm algo(graph);
+  algo.SetTimeLimit(consts.kExactSeconds);
+  algo.RunAlgorithm();
+  if (!algo.IsOptimal() && graph.GetGraph().size() <= consts.kHeldKarpSize) {
+    return SolveTsmHeldKarp(graph);
+  }
+  return algo.GetResult();
+}
+
+/**
+ * @brief Dijkstra's algorithm over the adjacency matrix. Stops as soon as all
+ * the target vertices are settled, empty targets run the search to the end.
+ *
+ * @param graph Adjacency matrix
+ * @param source Zero-based starting vertex
+ * @param targets Zero-based final vertices
+ * @return GraphAlgorithms::Vector The distances, -1 for unreachable vertices.
+ * After an early stop only the targets distances are guaranteed to be final
+ */
+GraphAlgorithms::Vector GraphAlgorithms::Dijkstra(const Graph& graph,
+                                                  int source,
+                                                  const Vector& targets) {
+  const int kInfinity = std::numeric_limits<int>::max();
+  const Matrix& m = graph.GetGraph();
+  Vector min_distance(m.size(), kInfinity);
+  min_distance[source] = 0;
+  std::vector<bool> is_target(m.size());
+  size_t targets_left = 0;
+  for (int target : targets) {
+    if (!is_target[target]) ++targets_left;
+    is_target[target] = true;
+  }
+
+  std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                      std::greater<std::pair<int, int>>>
+      dist_to_vertex;
+  dist_to_vertex.push(std::make_pair(min_distance[source], source));
+
+  while (!dist_to_vertex.empty()) {
+    auto [curr_dist, curr_ver] = dist_to_vertex.top();
+    dist_to_vertex.pop();
+    if (curr_dist > min_distance[curr_ver]) continue;
+    if (is_target[curr_ver] && --targets_left == 0) break;
+
+    for (std::size_t v = 0; v < m.size(); ++v) {
+      int edge_weight = m[curr_ver][v];
+
+      if (edge_weight != 0 && curr_dist + edge_weight < min_distance[v]) {
+        min_distance[v] = curr_dist + edge_weight;
+        dist_to_vertex.push(std::make_pair(min_distance[v], v));
+      }
+    }
+  }
+  std::replace(min_distance.begin(), min_distance.end(), kInfinity, -1);
+  return min_distance;
+}
+
+void GraphAlgorithms::CheckSpanningTreeGraph(const Graph& graph) {
+  if (graph.IsDirected()) {
+    throw std::logic_error("Algoritm deal with undirected graphs only");
+  }
+  if (graph.GetGraph().size() < 2) {
+    throw std::logic_error("The size of graph is less than necessary");
+  }
+}
+
+/**
+ * @brief Returns the tree or forest given by edges with its total weight
+ *
+ * @param graph
+ * @param edges
+ * @param forest If false, throws when the edges do not span all vertices
+ * @return MstResult
+ */
+MstResult GraphAlgorithms::SpanningTree(const Graph& graph, const Edges& edges,
+                                        bool forest) {
+  const size_t size = graph.GetGraph().size();
+  if (!forest && edges.size() + 1 != size) {
+    throw std::logic_error("The graph is disconnected, use spanning forest");
+  }
+  MstResult result{edges, 0, size};
+  for (const Edge& edge : edges) result.weight += edge.weight;
+  return result;
+}
+
+/**
+ * @brief Returns edges between vertices and their parents, -1 for the root and
+ * unreached vertices
+ *
+ * @param graph
+ * @param parent
+ * @return GraphAlgorithms::Edges
+ */
+GraphAlgorithms::Edges GraphAlgorithms::ParentEdges(const Graph& graph,
+                                                    const Vector& parent) {
+  Edges edges;
+  for (size_t v = 0; v < parent.size(); ++v) {
+    if (parent[v] != -1) {
+      edges.push_back({parent[v], static_cast<int>(v),
+                       graph.GetGraph()[parent[v]][v]});
+    }
+  }
+  return edges;
+}
+
+/**
+ * @brief Returns edges of undirected graph, each once with from < to
+ *
+ * @param graph
+ * @return GraphAlgorithms::Edges
+ */
+GraphAlgorithms::Edges GraphAlgorithms::GetEdges(const Graph& graph) {
+  const Matrix& m = graph.GetGraph();
+  Edges edges;
+  for (size_t i = 0; i < m.size(); ++i) {
+    for (size_t j = i + 1; j < m.size(); ++j) {
+      if (m[i][j] != 0) {
+        edges.push_back({static_cast<int>(i), static_cast<int>(j), m[i][j]});
+      }
+    }
+  }
+  return edges;
+}
+
+/**
+ * @brief Strict order of edges by weight, ties are broken by vertices so that
+ * all the algorithms agree on one minimal spanning tree
+ *
+ */
+bool GraphAlgorithms::EdgeLess(const Edge& edge1, const Edge& edge2) {
+  return std::tie(edge1.weight, edge1.from, edge1.to) <
+         std::tie(edge2.weight, edge2.from, edge2.to);
+}
+
+/**
+ * @brief Kruskal's algorithm: edges sorted by weight in parallel are added
+ * one by one unless they close a cycle
+ *
+ * @param graph
+ * @param threads
+ * @return GraphAlgorithms::Edges The edges of the minimal spanning forest
+ */
+GraphAlgorithms::Edges GraphAlgorithms::Kruskal(const Graph& graph,
+                                                size_t threads) {
+  Edges edges = GetEdges(graph);
+  {
+    ThreadPool pool(threads);
+    ParallelSort(pool, edges.begin(), edges.end(), EdgeLess);
+  }
+  const size_t size = graph.GetGraph().size();
+  DisjointSet sets(size);
+  Edges tree;
+  for (const Edge& edge : edges) {
+    if (tree.size() + 1 == size) break;
+    if (sets.Unite(edge.from, edge.to)) tree.push_back(edge);
+  }
+  return tree;
+}
+
+/**
+ * @brief Borůvka's algorithm: on every round each component is joined by its
+ * cheapest outgoing edge. Threads scan their parts of the edges for the
+ * cheapest edge of every component, then the parts are reduced in parallel.
+ *
+ * @param graph
+ * @param threads
+ * @return GraphAlgorithms::Edges The edges of the minimal spanning forest
+ */
+GraphAlgorithms::Edges GraphAlgorithms::Boruvka(const Graph& graph,
+                                                size_t threads) {
+  const Edges edges = GetEdges(graph);
+  const size_t size = graph.GetGraph().size();
+  ThreadPool pool(threads);
+  const size_t parts = pool.GetThreadsCount();
+  DisjointSet sets(size);
+  Vector component(size);
+  std::vector<Vector> cheapest(parts, Vector(size));
+  auto is_cheaper = [&edges](int edge, int best) {
+    return best == -1 || EdgeLess(edges[edge], edges[best]);
+  };
+  Edges tree;
+  bool merged = true;
+  while (merged) {
+    for (size_t v = 0; v < size; ++v) component[v] = sets.Find(v);
+    pool.ParallelFor(parts, [&](size_t part, size_t) {
+      Vector& best = cheapest[part];
+      std::fill(best.begin(), best.end(), -1);
+      size_t end = edges.size() * (part + 1) / parts;
+      for (size_t e = edges.size() * part / parts; e < end; ++e) {
+        int a = component[edges[e].from], b = component[edges[e].to];
+        if (a == b) continue;
+        if (is_cheaper(e, best[a])) best[a] = e;
+        if (is_cheaper(e, best[b])) best[b] = e;
+      }
+    });
+    pool.ParallelFor(parts, [&](size_t part, size_t) {
+      size_t end = size * (part + 1) / parts;
+      for (size_t c = size * part / parts; c < end; ++c) {
+        for (size_t other = 1; other < parts; ++other) {
+          int edge = cheapest[other][c];
+          if (edge != -1 && is_cheaper(edge, cheapest[0][c])) {
+            cheapest[0][c] = edge;
+          }
+        }
+      }
+    });
+    merged = false;
+    for (size_t c = 0; c < size; ++c) {
+      if (cheapest[0][c] == -1) continue;
+      const Edge& edge = edges[cheapest[0][c]];
+      if (sets.Unite(edge.from, edge.to)) {
+        tree.push_back(edge);
+        merged = true;
+      }
+    }
+  }
+  return tree;
+}
+
 bool GraphAlgorithms::IsCorrectVertex(int vertex, const Graph& graph) {
   if (vertex < 1 || vertex > static_cast<int>(graph.GetGraph().size())) {
     return false;
@@ -1,16 +1,28 @@
 #ifndef SRC_LIB_S21_GRAPH_ALGORITHMS_H
 #define SRC_LIB_S21_GRAPH_ALGORITHMS_H
 
+#include <cmath>
 #include <limits>
+#include <map>
 #include <queue>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 
+#include "../misc/disjoint_set.h"
 #include "../misc/queue.h"
 #include "../misc/stack.h"
+#include "../misc/thread_pool.h"
+#include "all_pairs_shortest_paths.h"
 #include "annealing_algorithm.h"
 #include "ant_algorithm.h"
+#include "branch_and_bound_algorithm.h"
+#include "delta_stepping.h"
 #include "genetic_algorithm.h"
+#include "held_karp_algorithm.h"
+#include "lin_kernighan_algorithm.h"
+#include "mstresult.h"
+#include "portfolio_solver.h"
 #include "s21_graph.h"
 #include "tsmresult.h"
 
@@ -18,19 +30,61 @@ class GraphAlgorithms {
  public:
   using Matrix = std::vector<std::vector<int> >;
   using Vector = std::vector<int>;
+  using Pairs = std::vector<std::pair<int, int>>;
+  using Edge = MstResult::Edge;
+  using Edges = std::vector<Edge>;
 
   static Vector DepthFirstSearch(const Graph& graph, int start_vertex);
   static Vector BreadthFirstSearch(const Graph& graph, int start_vertex);
   static int GetShortestPathBetweenVertices(const Graph& graph, int vertex1,
                                             int vertex2);
+  static Vector GetShortestPathsFromVertex(const Graph& graph, int vertex);
+  static Vector GetShortestPathsBetweenPairs(const Graph& graph,
+                                             const Pairs& pairs,
+                                             size_t threads = 0);
+  static Vector GetShortestPathsDeltaStepping(const Graph& graph, int vertex,
+                                              size_t threads = 0);
   static Matrix GetShortestPathsBetweenAllVertices(const Graph& graph);
   static Matrix GetLeastSpanningTree(const Graph& graph);
-  static TsmResult SolveTravelingSalesmanProblem(const Graph& graph);
-  static TsmResult SolveTsmSimulatedAnnealing(const Graph& graph);
-  static TsmResult SolveTsmGenetic(const Graph& graph);
+  static MstResult GetLeastSpanningTreeEdges(const Graph& graph);
+  static MstResult GetLeastSpanningTreeDense(const Graph& graph);
+  static MstResult GetLeastSpanningTreeSparse(const Graph& graph);
+  static MstResult GetLeastSpanningTreeKruskal(const Graph& graph,
+                                               size_t threads = 0);
+  static MstResult GetLeastSpanningTreeBoruvka(const Graph& graph,
+                                               size_t threads = 0);
+  static MstResult GetLeastSpanningForest(const Graph& graph);
+  static TsmResult SolveTravelingSalesmanProblem(
+      const Graph& graph, uint64_t seed = Random::MakeSeed());
+  static TsmResult SolveTsmSimulatedAnnealing(
+      const Graph& graph, uint64_t seed = Random::MakeSeed());
+  static TsmResult SolveTsmGenetic(const Graph& graph,
+                                   uint64_t seed = Random::MakeSeed());
+  static TsmResult SolveTsmLinKernighan(const Graph& graph,
+                                        double seconds = 0.0,
+                                        uint64_t seed = Random::MakeSeed());
+  static TsmResult SolveTsmHeldKarp(const Graph& graph);
+  static TsmResult SolveTsmBranchAndBound(const Graph& graph,
+                                          double seconds = 0.0);
+  static TsmResult SolveTsmPortfolio(const Graph& graph, double seconds = 0.0,
+                                     uint64_t seed = Random::MakeSeed());
 
  private:
   static bool IsCorrectVertex(int vertex, const Graph&);
+  static void CheckSpanningTreeGraph(const Graph& graph);
+  static MstResult SpanningTree(const Graph& graph, const Edges& edges,
+                                bool forest);
+  static Edges PrimDense(const Graph& graph);
+  static Edges PrimSparse(const Graph& graph);
+  static Edges ParentEdges(const Graph& graph, const Vector& parent);
+  static Edges GetEdges(const Graph& graph);
+  static bool EdgeLess(const Edge& edge1, const Edge& edge2);
+  static Edges Kruskal(const Graph& graph, size_t threads);
+  static Edges Boruvka(const Graph& graph, size_t threads);
+  static Vector Dijkstra(const Graph& graph, int source,
+                         const Vector& targets);
+  static bool IsSmallTsm(const Graph& graph);
+  static TsmResult SolveSmallTsm(const Graph& graph);
 };
 
 #endif  // SRC_LIB_S21_GRAPH_ALGORITHMS_H
@@ -0,0 +1,368 @@
+#include "tour_construction.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+#include "../misc/disjoint_set.h"
+
+/**
+ * @brief Construct a new Tour Construction:: Tour Construction object
+ *
+ * @param graph
+ */
+TourConstruction::TourConstruction(const Graph &graph)
+    : graph_{graph}, symmetric_{!graph.IsDirected()} {
+  long long largest = 0;
+  for (const auto &row : graph.GetGraph()) {
+    for (int weight : row) largest = std::max<long long>(largest, weight);
+  }
+  missing_ = largest * graph.GetGraph().size() + 1;
+}
+
+/**
+ * @brief Returns the nearest neighbour tour: from the start vertex the tour
+ * goes to the nearest unvisited vertex until all of them are visited, O(n^2)
+ *
+ * @param start Zero-based first vertex
+ * @return TourConstruction::Tour
+ */
+TourConstruction::Tour TourConstruction::NearestNeighbour(int start) const {
+  const int size = graph_.GetGraph().size();
+  if (size == 0) return Tour();
+  if (start < 0 || start >= size) {
+    throw std::out_of_range("Vertex index out of range");
+  }
+  std::vector<char> visited(size, false);
+  Tour tour(1, start);
+  visited[start] = true;
+  while (static_cast<int>(tour.size()) < size) {
+    int current = tour.back(), next = -1;
+    for (int v = 0; v < size; ++v) {
+      if (visited[v]) continue;
+      if (next == -1 || Cost(current, v) < Cost(current, next)) next = v;
+    }
+    tour.push_back(next);
+    visited[next] = true;
+  }
+  return tour;
+}
+
+/**
+ * @brief Returns the greedy edge tour: edges are taken cheapest first unless
+ * a vertex would get a third edge (on directed graphs a second outgoing or
+ * incoming one) or the edge would close a cycle, O(n^2 log n). The paths
+ * left when the edges run out are joined nearest end first.
+ *
+ * @return TourConstruction::Tour
+ */
+TourConstruction::Tour TourConstruction::GreedyEdge() const {
+  const Graph::Matrix &m = graph_.GetGraph();
+  const int size = m.size();
+  std::vector<std::tuple<int, int, int>> edges;
+  for (int i = 0; i < size; ++i) {
+    for (int j = symmetric_ ? i + 1 : 0; j < size; ++j) {
+      if (i != j && m[i][j] != 0) edges.emplace_back(m[i][j], i, j);
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  std::vector<std::vector<int>> links(size);
+  std::vector<char> entered(size, false);
+  DisjointSet sets(size);
+  for (const auto &[weight, from, to] : edges) {
+    if (links[from].size() == (symmetric_ ? 2u : 1u)) continue;
+    if (symmetric_ ? links[to].size() == 2 : entered[to]) continue;
+    if (!sets.Unite(from, to)) continue;
+    links[from].push_back(to);
+    if (symmetric_) links[to].push_back(from);
+    entered[to] = true;
+  }
+  std::vector<Tour> paths;
+  std::vector<char> visited(size, false);
+  for (int v = 0; v < size; ++v) {
+    bool head = symmetric_ ? links[v].size() < 2 : !entered[v];
+    if (visited[v] || !head) continue;
+    paths.emplace_back();
+    for (int current = v, previous = -1; current != -1;) {
+      paths.back().push_back(current);
+      visited[current] = true;
+      int next = -1;
+      for (int u : links[current]) {
+        if (u != previous) next = u;
+      }
+      previous = current;
+      current = next;
+    }
+  }
+  return JoinPaths(&paths);
+}
+
+/**
+ * @brief Returns the Christofides-style tour of a symmetric graph: the
+ * minimum spanning tree and a greedy matching of its vertices of odd degree
+ * make a graph with an Euler circuit, the circuit without repeated vertices
+ * is the tour, O(n^2 log n). The matching is greedy instead of a minimum
+ * one, so there is no bound of 3/2 of the optimum. Directed graphs get the
+ * greedy edge tour.
+ *
+ * @return TourConstruction::Tour
+ */
+TourConstruction::Tour TourConstruction::Christofides() const {
+  const int size = graph_.GetGraph().size();
+  if (!symmetric_) return GreedyEdge();
+  if (size < 3) return NearestNeighbour();
+  std::vector<Edge> edges = GetSpanningTree();
+  std::vector<int> degrees(size, 0);
+  for (const Edge &edge : edges) {
+    ++degrees[edge.first];
+    ++degrees[edge.second];
+  }
+  std::vector<int> odd;
+  for (int v = 0; v < size; ++v) {
+    if (degrees[v] % 2) odd.push_back(v);
+  }
+  std::vector<Edge> matching = GetMatching(odd);
+  edges.insert(edges.end(), matching.begin(), matching.end());
+  return GetEulerTour(edges);
+}
+
+/**
+ * @brief Returns the tour of the points in the order of the Hilbert curve
+ * over their bounding box, O(n log n). Points near each other on the plane
+ * are mostly near each other on the curve, so the tour is within O(log n)
+ * of the optimum for the Euclidean distances.
+ *
+ * @param points
+ * @return TourConstruction::Tour
+ */
+TourConstruction::Tour TourConstruction::SpaceFillingCurve(
+    const std::vector<Point> &points) {
+  constexpr uint32_t kSide = 1u << 16;
+  double min_x = std::numeric_limits<double>::infinity(), min_y = min_x;
+  double max_x = -min_x, max_y = -min_x;
+  for (const Point &point : points) {
+    min_x = std::min(min_x, point.x);
+    min_y = std::min(min_y, point.y);
+    max_x = std::max(max_x, point.x);
+    max_y = std::max(max_y, point.y);
+  }
+  double scale = std::max(max_x - min_x, max_y - min_y);
+  scale = scale > 0.0 ? (kSide - 1) / scale : 0.0;
+  std::vector<uint64_t> keys(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    uint32_t x = static_cast<uint32_t>((points[i].x - min_x) * scale);
+    uint32_t y = static_cast<uint32_t>((points[i].y - min_y) * scale);
+    uint64_t key = 0;
+    for (uint32_t s = kSide / 2; s > 0; s /= 2) {
+      uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+      key += uint64_t{s} * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+        if (rx == 1) {
+          x = kSide - 1 - x;
+          y = kSide - 1 - y;
+        }
+        std::swap(x, y);
+      }
+    }
+    keys[i] = key;
+  }
+  Tour tour(points.size());
+  std::iota(tour.begin(), tour.end(), 0);
+  std::stable_sort(tour.begin(), tour.end(),
+                   [&keys](int x, int y) { return keys[x] < keys[y]; });
+  return tour;
+}
+
+/**
+ * @brief Returns the length of the cyclic tour, infinity if it has a missing
+ * edge
+ *
+ * @param tour
+ * @return double
+ */
+double TourConstruction::GetLength(const Tour &tour) const {
+  return GetLength(graph_, tour);
+}
+
+/**
+ * @brief Returns the length of the cyclic tour of the graph, infinity if it
+ * has a missing edge
+ *
+ * @param graph
+ * @param tour
+ * @return double
+ */
+double TourConstruction::GetLength(const Graph &graph, const Tour &tour) {
+  const Graph::Matrix &m = graph.GetGraph();
+  double length = 0.0;
+  for (size_t i = 0; i < tour.size(); ++i) {
+    int weight = m[tour[i]][tour[(i + 1) % tour.size()]];
+    if (weight == 0) return std::numeric_limits<double>::infinity();
+    length += weight;
+  }
+  return length;
+}
+
+/**
+ * @brief Returns true if the tour is a permutation of [0, size)
+ *
+ * @param tour
+ * @param size Number of vertices
+ * @return true
+ * @return false
+ */
+bool TourConstruction::IsTour(const Tour &tour, size_t size) {
+  if (tour.size() != size) return false;
+  std::vector<char> seen(size, false);
+  for (int v : tour) {
+    if (v < 0 || static_cast<size_t>(v) >= size || seen[v]) return false;
+    seen[v] = true;
+  }
+  return true;
+}
+
+/**
+ * @brief Joins the paths into a tour starting from the first one: the tour
+ * goes on by the path whose first vertex, or either end on symmetric
+ * graphs, is the nearest to its last vertex, O(p^2) for p paths
+ *
+ * @param paths Paths covering all the vertices, moved into the tour
+ * @return TourConstruction::Tour
+ */
+TourConstruction::Tour TourConstruction::JoinPaths(
+    std::vector<Tour> *paths) const {
+  if (paths->empty()) return Tour();
+  Tour tour = std::move(paths->front());
+  std::vector<char> joined(paths->size(), false);
+  joined[0] = true;
+  for (size_t step = 1; step < paths->size(); ++step) {
+    size_t next = 0;
+    bool reversed = false;
+    long long best = std::numeric_limits<long long>::max();
+    for (size_t i = 1; i < paths->size(); ++i) {
+      if (joined[i]) continue;
+      const Tour &path = (*paths)[i];
+      if (Cost(tour.back(), path.front()) < best) {
+        best = Cost(tour.back(), path.front());
+        next = i;
+        reversed = false;
+      }
+      if (symmetric_ && Cost(tour.back(), path.back()) < best) {
+        best = Cost(tour.back(), path.back());
+        next = i;
+        reversed = true;
+      }
+    }
+    Tour &path = (*paths)[next];
+    if (reversed) std::reverse(path.begin(), path.end());
+    tour.insert(tour.end(), path.begin(), path.end());
+    joined[next] = true;
+  }
+  return tour;
+}
+
+/**
+ * @brief Returns the edges of the minimum spanning tree by Prim's algorithm
+ * in O(n^2), missing edges join the parts of a disconnected graph
+ *
+ * @return std::vector<TourConstruction::Edge>
+ */
+std::vector<TourConstruction::Edge> TourConstruction::GetSpanningTree() const {
+  const int size = graph_.GetGraph().size();
+  std::vector<long long> key(size, std::numeric_limits<long long>::max());
+  std::vector<int> parent(size, -1);
+  std::vector<char> in_tree(size, false);
+  std::vector<Edge> edges;
+  key[0] = 0;
+  for (int step = 0; step < size; ++step) {
+    int current = -1;
+    for (int v = 0; v < size; ++v) {
+      if (!in_tree[v] && (current == -1 || key[v] < key[current])) current = v;
+    }
+    in_tree[current] = true;
+    if (parent[current] != -1) edges.emplace_back(parent[current], current);
+    for (int v = 0; v < size; ++v) {
+      if (!in_tree[v] && Cost(current, v) < key[v]) {
+        key[v] = Cost(current, v);
+        parent[v] = current;
+      }
+    }
+  }
+  return edges;
+}
+
+/**
+ * @brief Returns a perfect matching of the vertices, cheapest pairs first,
+ * O(k^2 log k) for k vertices
+ *
+ * @param vertices Even number of vertices
+ * @return std::vector<TourConstruction::Edge>
+ */
+std::vector<TourConstruction::Edge> TourConstruction::GetMatching(
+    const std::vector<int> &vertices) const {
+  std::vector<std::tuple<long long, int, int>> pairs;
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    for (size_t j = i + 1; j < vertices.size(); ++j) {
+      pairs.emplace_back(Cost(vertices[i], vertices[j]), vertices[i],
+                         vertices[j]);
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  std::vector<char> matched(graph_.GetGraph().size(), false);
+  std::vector<Edge> edges;
+  for (const auto &[cost, from, to] : pairs) {
+    if (matched[from] || matched[to]) continue;
+    matched[from] = matched[to] = true;
+    edges.emplace_back(from, to);
+  }
+  return edges;
+}
+
+/**
+ * @brief Returns the vertices of an Euler circuit of the multigraph from
+ * vertex 0 by Hierholzer's algorithm in the order of their first visits
+ *
+ * @param edges Edges of a connected multigraph with even degrees
+ * @return TourConstruction::Tour
+ */
+TourConstruction::Tour TourConstruction::GetEulerTour(
+    const std::vector<Edge> &edges) const {
+  const int size = graph_.GetGraph().size();
+  std::vector<std::vector<std::pair<int, size_t>>> adjacent(size);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    adjacent[edges[i].first].emplace_back(edges[i].second, i);
+    adjacent[edges[i].second].emplace_back(edges[i].first, i);
+  }
+  std::vector<char> used(edges.size(), false), visited(size, false);
+  std::vector<size_t> next(size, 0);
+  std::vector<int> stack(1, 0);
+  Tour circuit;
+  while (!stack.empty()) {
+    int v = stack.back();
+    while (next[v] < adjacent[v].size() && used[adjacent[v][next[v]].second]) {
+      ++next[v];
+    }
+    if (next[v] == adjacent[v].size()) {
+      circuit.push_back(v);
+      stack.pop_back();
+    } else {
+      used[adjacent[v][next[v]].second] = true;
+      stack.push_back(adjacent[v][next[v]].first);
+    }
+  }
+  Tour tour;
+  for (int v : circuit) {
+    if (visited[v]) continue;
+    visited[v] = true;
+    tour.push_back(v);
+  }
+  return tour;
+}
+
+long long TourConstruction::Cost(int from, int to) const {
+  int weight = graph_.GetGraph()[from][to];
+  return weight != 0 ? weight : missing_;
+}
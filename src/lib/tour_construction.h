@@ -0,0 +1,54 @@
+#ifndef SRC_LIB_TOUR_CONSTRUCTION_H
+#define SRC_LIB_TOUR_CONSTRUCTION_H
+
+#include <utility>
+#include <vector>
+
+#include "s21_graph.h"
+
+/**
+ * @brief Constructive heuristics giving the initial tours of the TSM
+ * solvers, far shorter than random ones, in O(n^2 log n) at most. A tour is
+ * a zero-based cyclic permutation of the vertices, the closing vertex is not
+ * repeated. Missing edges cost more than any tour of existing edges, so they
+ * get into a tour only when the heuristic has no other choice.
+ *
+ */
+class TourConstruction {
+ public:
+  using Tour = std::vector<int>;
+
+  /**
+   * @brief Point of the plane, the input of the space-filling curve
+   *
+   */
+  struct Point {
+    double x;
+    double y;
+  };
+
+  explicit TourConstruction(const Graph &);
+
+  Tour NearestNeighbour(int start = 0) const;
+  Tour GreedyEdge() const;
+  Tour Christofides() const;
+  static Tour SpaceFillingCurve(const std::vector<Point> &points);
+  double GetLength(const Tour &tour) const;
+  static double GetLength(const Graph &, const Tour &tour);
+  static bool IsTour(const Tour &tour, size_t size);
+
+ private:
+  using Edge = std::pair<int, int>;
+
+  Tour JoinPaths(std::vector<Tour> *paths) const;
+  std::vector<Edge> GetSpanningTree() const;
+  std::vector<Edge> GetMatching(const std::vector<int> &vertices) const;
+  Tour GetEulerTour(const std::vector<Edge> &edges) const;
+  long long Cost(int from, int to) const;
+
+  const Graph &graph_;
+  bool symmetric_;
+  long long missing_ = 1;
+};
+
+#endif  // SRC_LIB_TOUR_CONSTRUCTION_H
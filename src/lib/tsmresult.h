@@ -1,6 +1,7 @@
 #ifndef SRC_LIB_TSMRESULT_H
 #define SRC_LIB_TSMRESULT_H
 
+#include <functional>
 #include <vector>
 
 /**
@@ -12,4 +13,22 @@ struct TsmResult {
   double distance = 0.0;
 };
 
+/**
+ * @brief Callback of the TSM solvers getting their new best tours while they
+ * run: a zero-based cyclic permutation of the vertices, the closing vertex is
+ * not repeated, and its length. Only tours of existing edges are passed.
+ * Solvers running several threads may call it concurrently.
+ *
+ */
+using TsmCallback = std::function<void(const TsmResult &)>;
+
+/**
+ * @brief Source of tours shared with the TSM solvers while they run, like the
+ * best tour of a portfolio: writes a zero-based cyclic tour of existing edges
+ * shorter than the length and returns true, or returns false if there is no
+ * such tour. Solvers running several threads may call it concurrently.
+ *
+ */
+using TsmSource = std::function<bool(double length, TsmResult *shorter)>;
+
 #endif  // SRC_LIB_TSMRESULT_H
@@ -0,0 +1,24 @@
+#ifndef SRC_MISC_CANCELLATION_TOKEN_H_
+#define SRC_MISC_CANCELLATION_TOKEN_H_
+
+#include <atomic>
+
+/**
+ * @brief Flag of cooperative cancellation shared between threads: one thread
+ * cancels, the workers poll the flag between their steps and stop on their
+ * own. A cancelled token stays cancelled.
+ *
+ */
+class CancellationToken {
+ public:
+  void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+  bool IsCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<bool> cancelled_{false};
+};
+
+#endif  // SRC_MISC_CANCELLATION_TOKEN_H_
@@ -0,0 +1,53 @@
+#ifndef SRC_MISC_DISJOINT_SET_H_
+#define SRC_MISC_DISJOINT_SET_H_
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Union-find over elements [0, size) with union by size and path
+ * compression
+ *
+ */
+class DisjointSet {
+ public:
+  explicit DisjointSet(size_t size)
+      : parent_(size), size_(size, 1), sets_(size) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+
+  int Find(int x) {
+    if (x < 0 || x >= static_cast<int>(parent_.size())) {
+      throw std::out_of_range("Disjoint set index out of range");
+    }
+    int root = x;
+    while (parent_[root] != root) root = parent_[root];
+    while (parent_[x] != root) {
+      int next = parent_[x];
+      parent_[x] = root;
+      x = next;
+    }
+    return root;
+  }
+
+  bool Unite(int x, int y) {
+    x = Find(x);
+    y = Find(y);
+    if (x == y) return false;
+    if (size_[x] < size_[y]) std::swap(x, y);
+    parent_[y] = x;
+    size_[x] += size_[y];
+    --sets_;
+    return true;
+  }
+
+  size_t GetSetsCount() const { return sets_; }
+
+ private:
+  std::vector<int> parent_;
+  std::vector<size_t> size_;
+  size_t sets_;
+};
+
+#endif  // SRC_MISC_DISJOINT_SET_H_
@@ -0,0 +1,132 @@
+#ifndef SRC_MISC_THREAD_POOL_H_
+#define SRC_MISC_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads executing submitted tasks. Tasks must not
+ * wait for other tasks of the same pool.
+ *
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t threads = DefaultThreadsCount()) {
+    if (threads == 0) threads = DefaultThreadsCount();
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { Work(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool &other) = delete;
+  ThreadPool &operator=(const ThreadPool &other) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for (auto &worker : workers_) worker.join();
+  }
+
+  static size_t DefaultThreadsCount() {
+    return std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  size_t GetThreadsCount() const { return workers_.size(); }
+
+  std::future<void> Submit(std::function<void()> task) {
+    auto packaged = std::make_shared<std::packaged_task<void()>>(task);
+    std::future<void> result = packaged->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push([packaged] { (*packaged)(); });
+    }
+    condition_.notify_one();
+    return result;
+  }
+
+  /**
+   * @brief Calls body(index, thread) for every index in [0, count), where
+   * thread is a number in [0, GetThreadsCount()) unique among concurrently
+   * running calls. Rethrows the first exception thrown by body.
+   *
+   */
+  void ParallelFor(size_t count,
+                   const std::function<void(size_t, size_t)> &body) {
+    std::atomic<size_t> next{0};
+    std::vector<std::future<void>> results;
+    size_t threads = std::min(GetThreadsCount(), count);
+    for (size_t thread = 0; thread < threads; ++thread) {
+      results.push_back(Submit([&next, &body, count, thread] {
+        for (size_t i = next++; i < count; i = next++) body(i, thread);
+      }));
+    }
+    for (auto &result : results) result.wait();
+    for (auto &result : results) result.get();
+  }
+
+ private:
+  void Work() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (stop_ && tasks_.empty()) return;
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_ = false;
+};
+
+/**
+ * @brief Sorts the range by chunks in parallel and merges the sorted chunks
+ * pairwise, also in parallel
+ *
+ */
+template <class Iterator, class Compare>
+void ParallelSort(ThreadPool &pool, Iterator first, Iterator last,
+                  Compare comp) {
+  const size_t kMinChunk = 4096;
+  size_t size = last - first;
+  size_t chunks = std::min(pool.GetThreadsCount(), size / kMinChunk);
+  if (chunks < 2) {
+    std::sort(first, last, comp);
+    return;
+  }
+  std::vector<size_t> bounds(chunks + 1);
+  for (size_t i = 0; i <= chunks; ++i) bounds[i] = size * i / chunks;
+  pool.ParallelFor(chunks, [&](size_t i, size_t) {
+    std::sort(first + bounds[i], first + bounds[i + 1], comp);
+  });
+  for (size_t width = 1; width < chunks; width *= 2) {
+    pool.ParallelFor((chunks + 2 * width - 1) / (2 * width),
+                     [&](size_t i, size_t) {
+                       size_t left = 2 * width * i;
+                       size_t middle = std::min(left + width, chunks);
+                       size_t right = std::min(left + 2 * width, chunks);
+                       std::inplace_merge(first + bounds[left],
+                                          first + bounds[middle],
+                                          first + bounds[right], comp);
+                     });
+  }
+}
+
+#endif  // SRC_MISC_THREAD_POOL_H_
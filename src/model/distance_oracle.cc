@@ -0,0 +1,163 @@
+#include "distance_oracle.h"
+
+/**
+ * @brief Construct a new Distance Oracle:: Distance Oracle object
+ *
+ * @param memory_limit Maximum size of cached distances in bytes
+ */
+DistanceOracle::DistanceOracle(size_t memory_limit)
+    : memory_limit_(memory_limit) {}
+
+/**
+ * @brief Returns the shortest distance between two vertices with the same
+ * contract as GraphAlgorithms::GetShortestPathBetweenVertices. Served from the
+ * all-pairs matrix or the distance tree of vertex1 if they are cached,
+ * otherwise the whole tree of vertex1 is computed and cached.
+ *
+ * @param graph
+ * @param vertex1 The starting vertex
+ * @param vertex2 The final vertex
+ * @return int The distance or -1 if vertex2 is unreachable
+ */
+int DistanceOracle::GetDistance(const Graph &graph, int vertex1, int vertex2) {
+  int size = graph.GetGraph().size();
+  if (vertex1 < 1 || vertex1 > size || vertex2 < 1 || vertex2 > size) {
+    throw std::logic_error("The index for vertex incorrect!");
+  }
+  CheckVersion(graph);
+  if (vertex1 == vertex2) {
+    ++hits_;
+    return 0;
+  }
+  if (has_matrix_) {
+    ++hits_;
+    int distance = matrix_[vertex1 - 1][vertex2 - 1];
+    return distance == 0 ? -1 : distance;
+  }
+  return GetTree(graph, vertex1 - 1)[vertex2 - 1];
+}
+
+/**
+ * @brief Returns the matrix of the shortest paths between all vertices with
+ * the same contract as GraphAlgorithms::GetShortestPathsBetweenAllVertices.
+ * The matrix is cached if it fits into the memory limit, cached distance trees
+ * are dropped then because the matrix answers all their queries.
+ *
+ * @param graph
+ * @return DistanceOracle::Matrix
+ */
+DistanceOracle::Matrix DistanceOracle::GetAllDistances(const Graph &graph) {
+  CheckVersion(graph);
+  if (has_matrix_) {
+    ++hits_;
+    return matrix_;
+  }
+  ++misses_;
+  Matrix m = GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  if (MatrixSize(m) <= memory_limit_) {
+    trees_.clear();
+    lru_.clear();
+    matrix_ = m;
+    has_matrix_ = true;
+    memory_usage_ = MatrixSize(matrix_);
+  }
+  return m;
+}
+
+/**
+ * @brief Drops all cached distances, counters are kept
+ *
+ */
+void DistanceOracle::Clear() {
+  matrix_.clear();
+  has_matrix_ = false;
+  trees_.clear();
+  lru_.clear();
+  memory_usage_ = 0;
+}
+
+/**
+ * @brief Returns number of queries served from the cache
+ *
+ * @return size_t
+ */
+size_t DistanceOracle::GetHits() const { return hits_; }
+
+/**
+ * @brief Returns number of queries which required a search
+ *
+ * @return size_t
+ */
+size_t DistanceOracle::GetMisses() const { return misses_; }
+
+/**
+ * @brief Returns size of cached distances in bytes
+ *
+ * @return size_t
+ */
+size_t DistanceOracle::GetMemoryUsage() const { return memory_usage_; }
+
+/**
+ * @brief Returns maximum size of cached distances in bytes
+ *
+ * @return size_t
+ */
+size_t DistanceOracle::GetMemoryLimit() const { return memory_limit_; }
+
+/**
+ * @brief Drops cached distances if they belong to another graph version
+ *
+ * @param graph
+ */
+void DistanceOracle::CheckVersion(const Graph &graph) {
+  if (graph.GetVersion() != version_) {
+    Clear();
+    version_ = graph.GetVersion();
+  }
+}
+
+/**
+ * @brief Returns distance tree of source vertex, computes and caches it on a
+ * miss. The least recently used trees are evicted to fit the memory limit.
+ *
+ * @param graph
+ * @param source Zero-based starting vertex
+ * @return const DistanceOracle::Vector&
+ */
+const DistanceOracle::Vector &DistanceOracle::GetTree(const Graph &graph,
+                                                      int source) {
+  auto it = trees_.find(source);
+  if (it != trees_.end()) {
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second.second);
+    return it->second.first;
+  }
+  ++misses_;
+  Vector tree = GraphAlgorithms::GetShortestPathsFromVertex(graph, source + 1);
+  size_t required = tree.size() * sizeof(int);
+  Evict(required);
+  lru_.push_front(source);
+  memory_usage_ += required;
+  return trees_.emplace(source, Tree(std::move(tree), lru_.begin()))
+      .first->second.first;
+}
+
+/**
+ * @brief Evicts the least recently used distance trees until required bytes
+ * fit into the memory limit. The most recent tree is always kept, even if it
+ * exceeds the limit alone.
+ *
+ * @param required
+ */
+void DistanceOracle::Evict(size_t required) {
+  while (!lru_.empty() && memory_usage_ + required > memory_limit_) {
+    auto it = trees_.find(lru_.back());
+    memory_usage_ -= it->second.first.size() * sizeof(int);
+    trees_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+size_t DistanceOracle::MatrixSize(const Matrix &m) {
+  return m.size() * m.size() * sizeof(int);
+}
@@ -0,0 +1,53 @@
+#ifndef SRC_MODEL_DISTANCE_ORACLE_H
+#define SRC_MODEL_DISTANCE_ORACLE_H
+
+#include <list>
+#include <unordered_map>
+
+#include "../lib/s21_graph_algorithms.h"
+
+/**
+ * @brief Cache of shortest path results for the last seen graph version.
+ * Keeps the all-pairs matrix and the single-source distance trees, point
+ * queries are answered from them without running a search again.
+ *
+ */
+class DistanceOracle {
+ public:
+  using Matrix = GraphAlgorithms::Matrix;
+  using Vector = GraphAlgorithms::Vector;
+
+  static constexpr size_t kDefaultMemoryLimit = 64 * 1024 * 1024;
+
+  explicit DistanceOracle(size_t memory_limit = kDefaultMemoryLimit);
+
+  int GetDistance(const Graph &graph, int vertex1, int vertex2);
+  Matrix GetAllDistances(const Graph &graph);
+  void Clear();
+
+  size_t GetHits() const;
+  size_t GetMisses() const;
+  size_t GetMemoryUsage() const;
+  size_t GetMemoryLimit() const;
+
+ private:
+  using Lru = std::list<int>;
+  using Tree = std::pair<Vector, Lru::iterator>;
+
+  void CheckVersion(const Graph &graph);
+  const Vector &GetTree(const Graph &graph, int source);
+  void Evict(size_t required);
+  static size_t MatrixSize(const Matrix &m);
+
+  size_t memory_limit_;
+  size_t memory_usage_ = 0;
+  size_t version_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+  bool has_matrix_ = false;
+  Matrix matrix_;
+  std::unordered_map<int, Tree> trees_;
+  Lru lru_;
+};
+
+#endif  // SRC_MODEL_DISTANCE_ORACLE_H
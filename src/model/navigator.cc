@@ -13,16 +13,15 @@ GraphAlgorithms::Vector Navigator::ThirdItem(int start) {
 }
 
 int Navigator::FourthItem(int vertex1, int vertex2) {
-  return GraphAlgorithms::GetShortestPathBetweenVertices(graph_, vertex1,
-                                                         vertex2);
+  return oracle_.GetDistance(graph_, vertex1, vertex2);
 }
 
 GraphAlgorithms::Matrix Navigator::FivthItem() {
-  return GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph_);
+  return oracle_.GetAllDistances(graph_);
 }
 
-GraphAlgorithms::Matrix Navigator::SixthItem() {
-  return GraphAlgorithms::GetLeastSpanningTree(graph_);
+MstResult Navigator::SixthItem() {
+  return GraphAlgorithms::GetLeastSpanningTreeEdges(graph_);
 }
 
 TsmResult Navigator::SeventhItem() {
@@ -38,6 +37,7 @@ std::vector<std::pair<double, double>> Navigator::EighthItem(int cycles) {
   AntAlgorithm ant(graph_);
   AnnealingAlgorithm annealing(graph_);
   GeneticAlgorithm genetic(graph_);
+  LinKernighanAlgorithm lin_kernighan(graph_);
 
   double start = std::clock();
   for (int i = cycles; i > 0; --i) {
@@ -51,7 +51,7 @@ std::vector<std::pair<double, double>> Navigator::EighthItem(int cycles) {
   start = std::clock();
   for (int i = cycles; i > 0; --i) {
     annealing.RunAlgorithm();
-    answers.insert(ant.GetResult().distance);
+    answers.insert(annealing.GetResult().distance);
   }
   end = std::clock();
   result.push_back({*answers.begin(), (end - start) / CLOCKS_PER_SEC});
@@ -60,10 +60,21 @@ std::vector<std::pair<double, double>> Navigator::EighthItem(int cycles) {
   start = std::clock();
   for (int i = cycles; i > 0; --i) {
     genetic.RunAlgorithm();
-    answers.insert(ant.GetResult().distance);
+    answers.insert(genetic.GetResult().distance);
+  }
+  end = std::clock();
+  result.push_back({*answers.begin(), (end - start) / CLOCKS_PER_SEC});
+  answers.clear();
+
+  start = std::clock();
+  for (int i = cycles; i > 0; --i) {
+    lin_kernighan.RunAlgorithm();
+    answers.insert(lin_kernighan.GetResult().distance);
   }
   end = std::clock();
   result.push_back({*answers.begin(), (end - start) / CLOCKS_PER_SEC});
 
   return result;
 }
+
+const DistanceOracle& Navigator::GetDistanceOracle() const { return oracle_; }
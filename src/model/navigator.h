@@ -5,6 +5,7 @@
 #include <set>
 
 #include "../lib/s21_graph_algorithms.h"
+#include "distance_oracle.h"
 
 class Navigator {
  public:
@@ -13,12 +14,14 @@ class Navigator {
   GraphAlgorithms::Vector ThirdItem(int start);
   int FourthItem(int vertex1, int vertex2);
   GraphAlgorithms::Matrix FivthItem();
-  GraphAlgorithms::Matrix SixthItem();
+  MstResult SixthItem();
   TsmResult SeventhItem();
   std::vector<std::pair<double, double>> EighthItem(int cycles);
+  const DistanceOracle& GetDistanceOracle() const;
 
  private:
   Graph graph_;
+  DistanceOracle oracle_;
 };
 
 #endif  // MODEL_NAVIGATOR_H
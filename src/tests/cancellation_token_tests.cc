@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include "../misc/cancellation_token.h"
+#include "../misc/thread_pool.h"
+
+TEST(CancellationToken, Cancel) {
+  CancellationToken token;
+  EXPECT_FALSE(token.IsCancelled());
+  token.Cancel();
+  EXPECT_TRUE(token.IsCancelled());
+  token.Cancel();
+  EXPECT_TRUE(token.IsCancelled());
+}
+
+TEST(CancellationToken, StopsWorkers) {
+  ThreadPool pool(4);
+  CancellationToken token;
+  std::atomic<int> stopped{0};
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 4; ++i) {
+    results.push_back(pool.Submit([&token, &stopped] {
+      while (!token.IsCancelled()) std::this_thread::yield();
+      ++stopped;
+    }));
+  }
+  token.Cancel();
+  for (auto& result : results) result.get();
+  EXPECT_EQ(stopped, 4);
+}
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+
+#include "../misc/disjoint_set.h"
+
+TEST(DisjointSet, Unite) {
+  DisjointSet set(10);
+  EXPECT_EQ(set.GetSetsCount(), 10U);
+  EXPECT_TRUE(set.Unite(0, 1));
+  EXPECT_TRUE(set.Unite(2, 3));
+  EXPECT_TRUE(set.Unite(1, 3));
+  EXPECT_FALSE(set.Unite(0, 2));
+  EXPECT_EQ(set.GetSetsCount(), 7U);
+  EXPECT_EQ(set.Find(0), set.Find(3));
+  EXPECT_NE(set.Find(0), set.Find(4));
+}
+
+TEST(DisjointSet, Chain) {
+  DisjointSet set(1000);
+  for (int i = 1; i < 1000; ++i) EXPECT_TRUE(set.Unite(i - 1, i));
+  EXPECT_EQ(set.GetSetsCount(), 1U);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(set.Find(i), set.Find(0));
+}
+
+TEST(DisjointSet, Exception) {
+  DisjointSet set(3);
+  EXPECT_THROW(set.Find(3), std::out_of_range);
+  EXPECT_THROW(set.Unite(-1, 0), std::out_of_range);
+}
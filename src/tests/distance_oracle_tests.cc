@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "../model/distance_oracle.h"
+
+TEST(DistanceOracle, point_queries) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  DistanceOracle oracle;
+  for (int i = 1; i <= 18; ++i) {
+    for (int j = 1; j <= 18; ++j) {
+      EXPECT_EQ(oracle.GetDistance(graph, i, j),
+                GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j));
+    }
+  }
+  EXPECT_EQ(oracle.GetMisses(), 18U);
+  EXPECT_EQ(oracle.GetHits(), 18U * 18U - 18U);
+}
+
+TEST(DistanceOracle, matrix_queries) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  DistanceOracle oracle;
+  GraphAlgorithms::Matrix m = oracle.GetAllDistances(graph);
+  EXPECT_TRUE(m == GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+  EXPECT_EQ(oracle.GetMisses(), 1U);
+  for (int i = 1; i <= 18; ++i) {
+    for (int j = 1; j <= 18; ++j) {
+      EXPECT_EQ(oracle.GetDistance(graph, i, j),
+                GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j));
+    }
+  }
+  EXPECT_TRUE(m == oracle.GetAllDistances(graph));
+  EXPECT_EQ(oracle.GetMisses(), 1U);
+  EXPECT_EQ(oracle.GetHits(), 18U * 18U + 1U);
+}
+
+TEST(DistanceOracle, graph_version) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  DistanceOracle oracle;
+  EXPECT_EQ(oracle.GetDistance(graph, 18, 14), 11);
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected3.txt");
+  EXPECT_EQ(oracle.GetDistance(graph, 12, 15), 4);
+  EXPECT_EQ(oracle.GetMisses(), 2U);
+  EXPECT_EQ(oracle.GetHits(), 0U);
+}
+
+TEST(DistanceOracle, memory_limit) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  DistanceOracle oracle(2 * 18 * sizeof(int));
+  oracle.GetDistance(graph, 1, 2);
+  oracle.GetDistance(graph, 2, 1);
+  oracle.GetDistance(graph, 1, 3);
+  oracle.GetDistance(graph, 3, 1);
+  EXPECT_EQ(oracle.GetMemoryUsage(), 2 * 18 * sizeof(int));
+  oracle.GetDistance(graph, 1, 4);
+  oracle.GetDistance(graph, 2, 4);
+  EXPECT_EQ(oracle.GetMisses(), 4U);
+  EXPECT_EQ(oracle.GetHits(), 2U);
+  oracle.GetAllDistances(graph);
+  EXPECT_EQ(oracle.GetMemoryUsage(), 2 * 18 * sizeof(int));
+  EXPECT_EQ(oracle.GetMisses(), 5U);
+}
+
+TEST(DistanceOracle, Exception) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  DistanceOracle oracle;
+  EXPECT_THROW(oracle.GetDistance(graph, 0, 1), std::logic_error);
+  EXPECT_THROW(oracle.GetDistance(graph, 1, 19), std::logic_error);
+}
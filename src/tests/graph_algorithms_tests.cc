@@ -1,11 +1,14 @@
 #include <gtest/gtest.h>
 
 #include "../lib/s21_graph_algorithms.h"
+#include "../lib/tour_construction.h"
 
 TEST(AntAlgorithm, CorrectFile) {
   Graph graph;
   graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
-  TsmResult result = GraphAlgorithms::SolveTravelingSalesmanProblem(graph);
+  AntAlgorithm algo(graph);
+  algo.RunAlgorithm();
+  TsmResult result = algo.GetResult();
   TsmResult solution = {{1, 3, 4, 2, 1}, 120};
   EXPECT_EQ(result.vertices.size(), solution.vertices.size());
   EXPECT_EQ(result.distance, solution.distance);
@@ -14,8 +17,145 @@ TEST(AntAlgorithm, CorrectFile) {
 TEST(AntAlgorithm, Exception) {
   Graph graph;
   graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
-  EXPECT_THROW(GraphAlgorithms::SolveTravelingSalesmanProblem(graph),
-               std::logic_error);
+  AntAlgorithm algo(graph);
+  algo.RunAlgorithm();
+  EXPECT_THROW(algo.GetResult(), std::logic_error);
+}
+
+TEST(AntAlgorithm, Seed) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  AntAlgorithm algo1(graph, 5), algo2(graph, 5);
+  algo1.RunAlgorithm();
+  algo2.RunAlgorithm();
+  TsmResult result1 = algo1.GetResult(), result2 = algo2.GetResult();
+  EXPECT_TRUE(result1.vertices == result2.vertices);
+  EXPECT_EQ(result1.distance, result2.distance);
+}
+
+TEST(AntAlgorithm, Threads) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  AntAlgorithm algo1(graph, 5), algo2(graph, 5);
+  algo1.SetThreadsCount(3);
+  algo2.SetThreadsCount(3);
+  algo1.RunAlgorithm();
+  algo2.RunAlgorithm();
+  TsmResult result1 = algo1.GetResult(), result2 = algo2.GetResult();
+  EXPECT_TRUE(result1.vertices == result2.vertices);
+  EXPECT_EQ(result1.distance, 120);
+  EXPECT_EQ(result2.distance, 120);
+}
+
+TEST(AntAlgorithm, Neighbours) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  AntAlgorithm algo(graph, 5);
+  algo.SetNeighboursCount(1);
+  algo.RunAlgorithm();
+  TsmResult result = algo.GetResult();
+  EXPECT_EQ(result.vertices.size(), 5U);
+  EXPECT_EQ(result.distance, 120);
+}
+
+TEST(AntAlgorithm, Modes) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  AntAlgorithm base(graph, 3);
+  base.RunAlgorithm();
+  double distance = base.GetResult().distance;
+  for (auto mode : {AntAlgorithm::Mode::kMaxMin,
+                    AntAlgorithm::Mode::kColonySystem}) {
+    for (bool polish : {false, true}) {
+      AntAlgorithm algo(graph, 3);
+      algo.SetMode(mode);
+      algo.SetLocalSearch(polish);
+      algo.RunAlgorithm();
+      TsmResult result = algo.GetResult();
+      EXPECT_EQ(result.vertices.size(), graph.GetGraph().size() + 1);
+      EXPECT_EQ(result.vertices.front(), result.vertices.back());
+      EXPECT_LE(result.distance, distance * 1.1);
+    }
+  }
+}
+
+TEST(AntAlgorithm, ModesException) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
+  for (auto mode : {AntAlgorithm::Mode::kMaxMin,
+                    AntAlgorithm::Mode::kColonySystem}) {
+    AntAlgorithm algo(graph, 3);
+    algo.SetMode(mode);
+    algo.SetLocalSearch(true);
+    algo.SetIterationsCount(50);
+    algo.RunAlgorithm();
+    EXPECT_THROW(algo.GetResult(), std::logic_error);
+  }
+}
+
+TEST(AntAlgorithm, Islands) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  std::vector<TsmResult> results;
+  for (size_t threads : {1, 3}) {
+    AntAlgorithm algo(graph, 7);
+    algo.SetMode(AntAlgorithm::Mode::kMaxMin);
+    algo.SetIslandsCount(4);
+    algo.SetMigrationInterval(20);
+    algo.SetThreadsCount(threads);
+    algo.RunAlgorithm();
+    results.push_back(algo.GetResult());
+  }
+  EXPECT_TRUE(results[0].vertices == results[1].vertices);
+  EXPECT_EQ(results[0].distance, results[1].distance);
+  EXPECT_EQ(results[0].vertices.size(), graph.GetGraph().size() + 1);
+}
+
+TEST(AntAlgorithm, SerialByDefault) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  AntAlgorithm serial(graph, 7);
+  serial.SetIslandsCount(1);
+  serial.SetThreadsCount(1);
+  serial.RunAlgorithm();
+  AntAlgorithm algo(graph, 7);
+  algo.RunAlgorithm();
+  EXPECT_TRUE(algo.GetResult().vertices == serial.GetResult().vertices);
+  EXPECT_EQ(algo.GetResult().distance, serial.GetResult().distance);
+}
+
+TEST(AntAlgorithm, InitialTour) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TsmResult optimum = GraphAlgorithms::SolveTsmHeldKarp(graph);
+  std::vector<int> tour(optimum.vertices.begin(), optimum.vertices.end() - 1);
+  for (int &v : tour) --v;
+  AntAlgorithm algo(graph, 1);
+  algo.SetIterationsCount(1);
+  algo.SetInitialTour(tour);
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 253);
+  EXPECT_THROW(algo.SetInitialTour({0, 1, 1}), std::logic_error);
+}
+
+TEST(AntAlgorithm, TourSource) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TsmResult optimum = GraphAlgorithms::SolveTsmHeldKarp(graph);
+  optimum.vertices.pop_back();
+  for (int &v : optimum.vertices) --v;
+  size_t calls = 0;
+  AntAlgorithm algo(graph, 1);
+  algo.SetIterationsCount(1);
+  algo.SetTourSource([&](double length, TsmResult *shorter) {
+    ++calls;
+    if (optimum.distance >= length) return false;
+    *shorter = optimum;
+    return true;
+  });
+  algo.RunAlgorithm();
+  EXPECT_EQ(calls, 1U);
+  EXPECT_EQ(algo.GetResult().distance, 253);
 }
 
 TEST(AnnealingAlgorithm, CorrectFile) {
@@ -27,22 +167,594 @@ TEST(AnnealingAlgorithm, CorrectFile) {
   EXPECT_EQ(result.distance, solution.distance);
 }
 
+TEST(AnnealingAlgorithm, Seed) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TsmResult result1 = GraphAlgorithms::SolveTsmSimulatedAnnealing(graph, 5);
+  TsmResult result2 = GraphAlgorithms::SolveTsmSimulatedAnnealing(graph, 5);
+  EXPECT_TRUE(result1.vertices == result2.vertices);
+  EXPECT_EQ(result1.distance, result2.distance);
+}
+
+TEST(AnnealingAlgorithm, Modes) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  for (auto mode : {AnnealingAlgorithm::Mode::kMultiStart,
+                    AnnealingAlgorithm::Mode::kTempering}) {
+    std::vector<TsmResult> results;
+    for (size_t threads : {1, 3}) {
+      AnnealingAlgorithm algo(graph, 9);
+      algo.SetMode(mode);
+      algo.SetReplicasCount(4);
+      algo.SetThreadsCount(threads);
+      algo.RunAlgorithm();
+      results.push_back(algo.GetResult());
+    }
+    EXPECT_TRUE(results[0].vertices == results[1].vertices);
+    EXPECT_EQ(results[0].distance, results[1].distance);
+    EXPECT_EQ(results[0].vertices.size(), graph.GetGraph().size());
+  }
+}
+
+TEST(AnnealingAlgorithm, TemperingCorrectFile) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  AnnealingAlgorithm algo(graph, 2);
+  algo.SetMode(AnnealingAlgorithm::Mode::kTempering);
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 120);
+}
+
+TEST(AnnealingAlgorithm, AttemptsBudget) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  AnnealingAlgorithm algo1(graph, 4), algo2(graph, 4);
+  algo1.SetAttemptsBudget(5000);
+  algo2.SetAttemptsBudget(5000);
+  algo1.RunAlgorithm();
+  algo2.RunAlgorithm();
+  EXPECT_EQ(algo1.GetResult().distance, 120);
+  EXPECT_TRUE(algo1.GetResult().vertices == algo2.GetResult().vertices);
+}
+
+TEST(AnnealingAlgorithm, TimeBudget) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  const double budget = 0.1, margin = 2.0;
+  for (auto mode : {AnnealingAlgorithm::Mode::kSingle,
+                    AnnealingAlgorithm::Mode::kMultiStart,
+                    AnnealingAlgorithm::Mode::kTempering}) {
+    AnnealingAlgorithm algo(graph, 4);
+    algo.SetMode(mode);
+    algo.SetTimeBudget(budget);
+    auto start = std::chrono::steady_clock::now();
+    algo.RunAlgorithm();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed.count(), budget);
+    EXPECT_LT(elapsed.count(), budget + margin);
+    EXPECT_EQ(algo.GetResult().vertices.size(), graph.GetGraph().size());
+  }
+}
+
+TEST(AnnealingAlgorithm, LocalSearch) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  AnnealingAlgorithm plain(graph, 5);
+  plain.SetAttemptsBudget(200);
+  plain.RunAlgorithm();
+  AnnealingAlgorithm polished(graph, 5);
+  polished.SetAttemptsBudget(200);
+  polished.SetLocalSearch(true);
+  polished.RunAlgorithm();
+  EXPECT_LE(polished.GetResult().distance, plain.GetResult().distance);
+  EXPECT_EQ(polished.GetResult().vertices.size(), graph.GetGraph().size());
+}
+
+TEST(AnnealingAlgorithm, InitialTour) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TourConstruction construction(graph);
+  std::vector<int> tour = construction.GreedyEdge();
+  for (auto mode : {AnnealingAlgorithm::Mode::kSingle,
+                    AnnealingAlgorithm::Mode::kTempering}) {
+    AnnealingAlgorithm algo(graph, 1);
+    algo.SetMode(mode);
+    algo.SetAttemptsBudget(1000);
+    algo.SetInitialTour(tour);
+    algo.RunAlgorithm();
+    TsmResult result = algo.GetResult();
+    EXPECT_TRUE(TourConstruction::IsTour(result.vertices, 11));
+    EXPECT_LE(result.distance, construction.GetLength(tour));
+  }
+  AnnealingAlgorithm algo(graph, 1);
+  EXPECT_THROW(algo.SetInitialTour({0, 1, 2}), std::logic_error);
+}
+
 TEST(GeneticAlgorithm, CorrectFile1) {
   Graph graph;
   graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
   TsmResult result = GraphAlgorithms::SolveTsmGenetic(graph);
-  TsmResult solution = {{1, 3, 4, 2}, 120};
+  TsmResult solution = {{1, 3, 4, 2, 1}, 120};
   EXPECT_EQ(result.vertices.size(), solution.vertices.size());
+  EXPECT_EQ(result.vertices.front(), 1);
+  EXPECT_EQ(result.vertices.back(), 1);
   EXPECT_EQ(result.distance, solution.distance);
 }
 
-TEST(GeneticAlgorithm, CorrectFile2) {
+TEST(GeneticAlgorithm, Exception) {
   Graph graph;
   graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
-  TsmResult result = GraphAlgorithms::SolveTsmGenetic(graph);
-  TsmResult solution = {{1, 3, 4, 2}, 5};
-  EXPECT_EQ(result.vertices.size(), solution.vertices.size());
-  EXPECT_EQ(result.distance, solution.distance);
+  EXPECT_THROW(GraphAlgorithms::SolveTsmGenetic(graph), std::logic_error);
+}
+
+TEST(GeneticAlgorithm, Seed) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TsmResult result1 = GraphAlgorithms::SolveTsmGenetic(graph, 5);
+  TsmResult result2 = GraphAlgorithms::SolveTsmGenetic(graph, 5);
+  EXPECT_TRUE(result1.vertices == result2.vertices);
+  EXPECT_EQ(result1.distance, result2.distance);
+}
+
+TEST(GeneticAlgorithm, RepeatedRuns) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  std::vector<std::vector<TsmResult>> runs(2);
+  for (auto &results : runs) {
+    GeneticAlgorithm algo(graph, 5);
+    algo.SetGenerationsCount(0);
+    for (int i = 0; i < 2; ++i) {
+      algo.RunAlgorithm();
+      results.push_back(algo.GetResult());
+    }
+  }
+  EXPECT_TRUE(runs[0][1].vertices == runs[1][1].vertices);
+  EXPECT_FALSE(runs[0][0].vertices == runs[0][1].vertices);
+}
+
+TEST(GeneticAlgorithm, Permutation) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  for (uint64_t seed = 0; seed < 5; ++seed) {
+    TsmResult result = GraphAlgorithms::SolveTsmGenetic(graph, seed);
+    EXPECT_EQ(result.vertices.front(), result.vertices.back());
+    std::vector<int> vertices(result.vertices.begin(),
+                              result.vertices.end() - 1);
+    std::sort(vertices.begin(), vertices.end());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      EXPECT_EQ(vertices[i], static_cast<int>(i) + 1);
+    }
+    EXPECT_EQ(vertices.size(), graph.GetGraph().size());
+  }
+}
+
+TEST(GeneticAlgorithm, Crossovers) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  for (auto crossover : {GeneticAlgorithm::Crossover::kOrder,
+                         GeneticAlgorithm::Crossover::kPartiallyMapped,
+                         GeneticAlgorithm::Crossover::kEdgeAssembly}) {
+    std::vector<TsmResult> results;
+    for (size_t threads : {1, 3}) {
+      GeneticAlgorithm algo(graph, 4);
+      algo.SetCrossover(crossover);
+      algo.SetPopulationSize(20);
+      algo.SetTournamentSize(3);
+      algo.SetMutationsCount(1);
+      algo.SetGenerationsCount(100);
+      algo.SetThreadsCount(threads);
+      algo.RunAlgorithm();
+      results.push_back(algo.GetResult());
+    }
+    EXPECT_TRUE(results[0].vertices == results[1].vertices);
+    EXPECT_EQ(results[0].distance, results[1].distance);
+    std::vector<int> vertices(results[0].vertices.begin(),
+                              results[0].vertices.end() - 1);
+    std::sort(vertices.begin(), vertices.end());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      EXPECT_EQ(vertices[i], static_cast<int>(i) + 1);
+    }
+    EXPECT_EQ(vertices.size(), graph.GetGraph().size());
+  }
+}
+
+TEST(GeneticAlgorithm, EdgeAssemblyCorrectFile) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  GeneticAlgorithm algo(graph, 6);
+  algo.SetCrossover(GeneticAlgorithm::Crossover::kEdgeAssembly);
+  algo.SetPopulationSize(10);
+  algo.SetTournamentSize(2);
+  algo.SetMutationsCount(1);
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 120);
+}
+
+TEST(GeneticAlgorithm, Islands) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  for (auto topology : {GeneticAlgorithm::Topology::kRing,
+                        GeneticAlgorithm::Topology::kRandom}) {
+    std::vector<TsmResult> results;
+    for (size_t threads : {1, 3}) {
+      GeneticAlgorithm algo(graph, 8);
+      algo.SetCrossover(GeneticAlgorithm::Crossover::kOrder);
+      algo.SetPopulationSize(10);
+      algo.SetTournamentSize(2);
+      algo.SetIslandsCount(4);
+      algo.SetMigrationInterval(10);
+      algo.SetMigrantsCount(2);
+      algo.SetTopology(topology);
+      algo.SetGenerationsCount(100);
+      algo.SetThreadsCount(threads);
+      algo.RunAlgorithm();
+      results.push_back(algo.GetResult());
+    }
+    EXPECT_TRUE(results[0].vertices == results[1].vertices);
+    EXPECT_EQ(results[0].distance, results[1].distance);
+    EXPECT_EQ(results[0].vertices.size(), graph.GetGraph().size() + 1);
+  }
+}
+
+TEST(GeneticAlgorithm, LocalSearch) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  std::vector<TsmResult> results;
+  for (size_t threads : {1, 3}) {
+    GeneticAlgorithm algo(graph, 3);
+    algo.SetCrossover(GeneticAlgorithm::Crossover::kOrder);
+    algo.SetPopulationSize(10);
+    algo.SetTournamentSize(2);
+    algo.SetGenerationsCount(20);
+    algo.SetLocalSearch(true);
+    algo.SetThreadsCount(threads);
+    algo.RunAlgorithm();
+    results.push_back(algo.GetResult());
+  }
+  EXPECT_TRUE(results[0].vertices == results[1].vertices);
+  EXPECT_EQ(results[0].vertices.size(), graph.GetGraph().size() + 1);
+}
+
+TEST(GeneticAlgorithm, InitialTour) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  GeneticAlgorithm algo(graph, 1);
+  algo.SetGenerationsCount(0);
+  algo.SetInitialTour({0, 1, 3, 2});
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 120);
+  EXPECT_THROW(algo.SetInitialTour({0, 1, 3, 4}), std::logic_error);
+}
+
+TEST(GeneticAlgorithm, TourSource) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TsmResult optimum = GraphAlgorithms::SolveTsmHeldKarp(graph);
+  optimum.vertices.pop_back();
+  for (int &v : optimum.vertices) --v;
+  GeneticAlgorithm algo(graph, 1);
+  algo.SetGenerationsCount(1);
+  algo.SetTourSource([&](double length, TsmResult *shorter) {
+    if (optimum.distance >= length) return false;
+    *shorter = optimum;
+    return true;
+  });
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 253);
+}
+
+TEST(LinKernighanAlgorithm, CorrectFile) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  LinKernighanAlgorithm algo(graph);
+  algo.RunAlgorithm();
+  TsmResult result = algo.GetResult();
+  EXPECT_EQ(result.vertices.size(), 5U);
+  EXPECT_EQ(result.vertices.front(), result.vertices.back());
+  EXPECT_EQ(result.distance, 120);
+}
+
+TEST(LinKernighanAlgorithm, Optimum) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  for (uint64_t seed : {1, 2, 3}) {
+    LinKernighanAlgorithm algo(graph, seed);
+    algo.RunAlgorithm();
+    TsmResult result = algo.GetResult();
+    std::vector<int> vertices(result.vertices.begin() + 1,
+                              result.vertices.end());
+    std::sort(vertices.begin(), vertices.end());
+    for (size_t i = 0; i < vertices.size(); ++i) EXPECT_EQ(vertices[i], i + 1);
+    EXPECT_EQ(result.distance, 253);
+  }
+}
+
+TEST(LinKernighanAlgorithm, Exception) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
+  LinKernighanAlgorithm algo(graph, 1);
+  algo.RunAlgorithm();
+  EXPECT_THROW(algo.GetResult(), std::logic_error);
+}
+
+TEST(LinKernighanAlgorithm, Directed) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  int size = graph.GetGraph().size();
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      if (i != j && graph.GetWeight(i, j) == 0) graph.SetWeight(i, j, 20);
+    }
+  }
+  LinKernighanAlgorithm algo1(graph, 5), algo2(graph, 5);
+  algo1.RunAlgorithm();
+  algo2.RunAlgorithm();
+  TsmResult result1 = algo1.GetResult(), result2 = algo2.GetResult();
+  EXPECT_TRUE(result1.vertices == result2.vertices);
+  EXPECT_EQ(result1.distance, result2.distance);
+  double distance = 0.0;
+  for (size_t i = 0; i + 1 < result1.vertices.size(); ++i) {
+    distance += graph.GetWeight(result1.vertices[i] - 1,
+                                result1.vertices[i + 1] - 1);
+  }
+  EXPECT_EQ(result1.distance, distance);
+  std::vector<int> vertices(result1.vertices.begin() + 1,
+                            result1.vertices.end());
+  std::sort(vertices.begin(), vertices.end());
+  for (int i = 0; i < size; ++i) EXPECT_EQ(vertices[i], i + 1);
+}
+
+TEST(LinKernighanAlgorithm, TimeLimit) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  LinKernighanAlgorithm descent(graph, 4), kicked(graph, 4);
+  descent.SetKicksCount(0);
+  descent.SetNeighboursCount(3);
+  descent.RunAlgorithm();
+  kicked.SetKicksCount(0);
+  kicked.SetNeighboursCount(3);
+  kicked.SetTimeLimit(0.05);
+  kicked.RunAlgorithm();
+  EXPECT_LE(kicked.GetResult().distance, descent.GetResult().distance);
+  EXPECT_EQ(kicked.GetResult().vertices.size(), graph.GetGraph().size() + 1);
+}
+
+TEST(LinKernighanAlgorithm, InitialTour) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  LinKernighanAlgorithm algo(graph, 1);
+  algo.SetInitialTour(TourConstruction(graph).Christofides());
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 253);
+  EXPECT_THROW(algo.SetInitialTour({0}), std::logic_error);
+}
+
+TEST(LinKernighanAlgorithm, TourSource) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TsmResult optimum = GraphAlgorithms::SolveTsmHeldKarp(graph);
+  optimum.vertices.pop_back();
+  for (int &v : optimum.vertices) --v;
+  LinKernighanAlgorithm algo(graph, 1);
+  algo.SetNeighboursCount(1);
+  algo.SetKicksCount(1);
+  algo.SetTourSource([&](double length, TsmResult *shorter) {
+    if (optimum.distance >= length) return false;
+    *shorter = optimum;
+    return true;
+  });
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 253);
+}
+
+TEST(HeldKarpAlgorithm, CorrectFile) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  TsmResult result = GraphAlgorithms::SolveTsmHeldKarp(graph);
+  EXPECT_EQ(result.vertices.size(), 5U);
+  EXPECT_EQ(result.vertices.front(), 1);
+  EXPECT_EQ(result.vertices.back(), 1);
+  EXPECT_EQ(result.distance, 120);
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  EXPECT_EQ(GraphAlgorithms::SolveTsmHeldKarp(graph).distance, 253);
+}
+
+TEST(HeldKarpAlgorithm, OneVertex) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_one_dot.txt");
+  TsmResult result = GraphAlgorithms::SolveTsmHeldKarp(graph);
+  EXPECT_TRUE(result.vertices == std::vector<int>({1, 1}));
+  EXPECT_EQ(result.distance, 10000);
+}
+
+TEST(HeldKarpAlgorithm, Exception) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
+  EXPECT_THROW(GraphAlgorithms::SolveTsmHeldKarp(graph), std::logic_error);
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  EXPECT_THROW(GraphAlgorithms::SolveTsmHeldKarp(graph), std::logic_error);
+}
+
+TEST(BranchAndBoundAlgorithm, HeldKarp) {
+  for (auto file : {"graph_undirected.txt", "graph_directed3.txt"}) {
+    Graph graph;
+    graph.LoadGraphFromFile(std::string("./resources/correct_graphs/") + file);
+    int size = graph.GetGraph().size();
+    for (int i = 0; i < size; ++i) {
+      for (int j = 0; j < size; ++j) {
+        if (i != j && graph.GetWeight(i, j) == 0) {
+          graph.SetWeight(i, j, 20 + (i * 7 + j * 3) % 11);
+        }
+      }
+    }
+    BranchAndBoundAlgorithm algo(graph);
+    algo.RunAlgorithm();
+    EXPECT_TRUE(algo.IsOptimal());
+    TsmResult result = algo.GetResult();
+    EXPECT_EQ(result.distance,
+              GraphAlgorithms::SolveTsmHeldKarp(graph).distance);
+    double distance = 0.0;
+    for (size_t i = 0; i + 1 < result.vertices.size(); ++i) {
+      distance +=
+          graph.GetWeight(result.vertices[i] - 1, result.vertices[i + 1] - 1);
+    }
+    EXPECT_EQ(result.distance, distance);
+    EXPECT_EQ(result.vertices.size(), graph.GetGraph().size() + 1);
+  }
+}
+
+TEST(BranchAndBoundAlgorithm, Exception) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
+  EXPECT_THROW(GraphAlgorithms::SolveTsmBranchAndBound(graph),
+               std::logic_error);
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  BranchAndBoundAlgorithm algo(graph);
+  algo.RunAlgorithm();
+  EXPECT_TRUE(algo.IsOptimal());
+  EXPECT_THROW(algo.GetResult(), std::logic_error);
+}
+
+/**
+ * @brief Runs the solver with a budget far beyond the test, the callback
+ * cancels it on the first tour, which the solver must return at most
+ *
+ */
+template <class Algorithm>
+void ExpectCancelled(Algorithm *algo, const Graph &graph) {
+  CancellationToken token;
+  std::vector<TsmResult> reports;
+  algo->SetCancellationToken(&token);
+  algo->SetProgressCallback([&](const TsmResult &result) {
+    reports.push_back(result);
+    token.Cancel();
+  });
+  algo->RunAlgorithm();
+  ASSERT_FALSE(reports.empty());
+  EXPECT_TRUE(TourConstruction::IsTour(reports[0].vertices,
+                                       graph.GetGraph().size()));
+  EXPECT_EQ(reports[0].distance,
+            TourConstruction::GetLength(graph, reports[0].vertices));
+  EXPECT_LE(algo->GetResult().distance, reports.back().distance);
+}
+
+TEST(AntAlgorithm, Cancellation) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  AntAlgorithm algo(graph, 1);
+  algo.SetIterationsCount(1000000000);
+  ExpectCancelled(&algo, graph);
+}
+
+TEST(AnnealingAlgorithm, Cancellation) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  AnnealingAlgorithm algo(graph, 1);
+  algo.SetTimeBudget(1000.0);
+  ExpectCancelled(&algo, graph);
+}
+
+TEST(GeneticAlgorithm, Cancellation) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  GeneticAlgorithm algo(graph, 1);
+  algo.SetGenerationsCount(1000000000);
+  ExpectCancelled(&algo, graph);
+}
+
+TEST(LinKernighanAlgorithm, Cancellation) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  LinKernighanAlgorithm algo(graph, 1);
+  algo.SetKicksCount(0);
+  algo.SetTimeLimit(1000.0);
+  ExpectCancelled(&algo, graph);
+}
+
+TEST(BranchAndBoundAlgorithm, LowerBound) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  BranchAndBoundAlgorithm algo(graph);
+  double bound = algo.FindLowerBound();
+  EXPECT_GT(bound, 0.0);
+  EXPECT_LE(bound, 253);
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetResult().distance, 253);
+}
+
+TEST(PortfolioSolver, CorrectFile) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  PortfolioSolver algo(graph, 1);
+  algo.RunAlgorithm();
+  TsmResult result = algo.GetResult();
+  EXPECT_EQ(result.distance, 253);
+  EXPECT_EQ(algo.GetLowerBound(), 253);
+  EXPECT_EQ(result.vertices.size(), graph.GetGraph().size() + 1);
+  EXPECT_EQ(result.vertices.front(), 1);
+  EXPECT_EQ(result.vertices.back(), 1);
+  EXPECT_EQ(GraphAlgorithms::SolveTsmPortfolio(graph, 10.0).distance, 253);
+}
+
+TEST(PortfolioSolver, TargetLength) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  PortfolioSolver algo(graph, 1);
+  algo.SetEngines({PortfolioSolver::Engine::kAnt,
+                   PortfolioSolver::Engine::kGenetic});
+  algo.SetTimeLimit(1000.0);
+  algo.SetTargetLength(1000000.0);
+  std::vector<TsmResult> reports;
+  algo.SetProgressCallback(
+      [&](const TsmResult &result) { reports.push_back(result); });
+  algo.RunAlgorithm();
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(algo.GetResult().distance, reports.back().distance);
+}
+
+TEST(PortfolioSolver, TargetGap) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  PortfolioSolver algo(graph, 1);
+  algo.SetEngines({PortfolioSolver::Engine::kAnnealing});
+  algo.SetTimeLimit(1000.0);
+  algo.SetTargetGap(1.0);
+  algo.RunAlgorithm();
+  double bound = algo.GetLowerBound();
+  EXPECT_GT(bound, 0.0);
+  EXPECT_LE(bound, 253);
+  EXPECT_LE(algo.GetResult().distance, 2.0 * bound);
+}
+
+TEST(PortfolioSolver, Exception) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  PortfolioSolver algo(graph, 1);
+  algo.RunAlgorithm();
+  EXPECT_EQ(algo.GetLowerBound(), std::numeric_limits<double>::infinity());
+  EXPECT_THROW(algo.GetResult(), std::logic_error);
+}
+
+TEST(GraphAlgorithms, SmallTsmIsExact) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  EXPECT_EQ(GraphAlgorithms::SolveTravelingSalesmanProblem(graph).distance,
+            253);
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
+  EXPECT_THROW(GraphAlgorithms::SolveTravelingSalesmanProblem(graph),
+               std::logic_error);
+}
+
+TEST(GraphAlgorithms, SolveTsmLinKernighan) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TsmResult result = GraphAlgorithms::SolveTsmLinKernighan(graph, 0.01, 1);
+  EXPECT_EQ(result.vertices.size(), graph.GetGraph().size() + 1);
+  EXPECT_EQ(result.vertices.front(), result.vertices.back());
+  EXPECT_GE(result.distance, 253);
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed2.txt");
+  EXPECT_THROW(GraphAlgorithms::SolveTsmLinKernighan(graph), std::logic_error);
 }
 
 TEST(MST, file_4_dots) {
@@ -305,4 +1017,194 @@ TEST(Dijkstra, Exception) {
   } catch (const std::exception& e) {
     SUCCEED();
   }
-}
\ No newline at end of file
+}
+
+TEST(Dijkstra, from_vertex) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  for (int i = 1; i <= 18; ++i) {
+    GraphAlgorithms::Vector distances =
+        GraphAlgorithms::GetShortestPathsFromVertex(graph, i);
+    for (int j = 1; j <= 18; ++j) {
+      EXPECT_EQ(distances[j - 1],
+                GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j));
+    }
+  }
+  EXPECT_THROW(GraphAlgorithms::GetShortestPathsFromVertex(graph, 19),
+               std::logic_error);
+}
+
+TEST(Dijkstra, between_pairs) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  GraphAlgorithms::Pairs pairs;
+  for (int i = 18; i >= 1; --i) {
+    for (int j = 1; j <= 18; j += i % 3 + 1) pairs.push_back({i, j});
+  }
+  for (size_t threads : {1, 4}) {
+    GraphAlgorithms::Vector distances =
+        GraphAlgorithms::GetShortestPathsBetweenPairs(graph, pairs, threads);
+    ASSERT_EQ(distances.size(), pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      EXPECT_EQ(distances[i], GraphAlgorithms::GetShortestPathBetweenVertices(
+                                  graph, pairs[i].first, pairs[i].second));
+    }
+  }
+  EXPECT_THROW(GraphAlgorithms::GetShortestPathsBetweenPairs(graph, {{1, 19}}),
+               std::logic_error);
+}
+
+TEST(DeltaStepping, same_as_dijkstra) {
+  for (auto file : {"graph_directed3.txt", "graph_undirected.txt",
+                    "graph_undirected3.txt"}) {
+    Graph graph;
+    graph.LoadGraphFromFile(std::string("./resources/correct_graphs/") + file);
+    for (int i = 1; i <= static_cast<int>(graph.GetGraph().size()); ++i) {
+      GraphAlgorithms::Vector expected =
+          GraphAlgorithms::GetShortestPathsFromVertex(graph, i);
+      for (size_t threads : {1, 3}) {
+        EXPECT_TRUE(GraphAlgorithms::GetShortestPathsDeltaStepping(
+                        graph, i, threads) == expected);
+      }
+    }
+  }
+}
+
+TEST(DeltaStepping, delta) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  EXPECT_EQ(DeltaStepping::ChooseDelta(graph), 10);
+  for (int delta : {1, 5, 50, 1000}) {
+    DeltaStepping algo(graph, delta);
+    algo.RunAlgorithm(6);
+    EXPECT_EQ(algo.GetDelta(), delta);
+    EXPECT_TRUE(algo.GetResult() ==
+                GraphAlgorithms::GetShortestPathsFromVertex(graph, 7));
+  }
+  EXPECT_THROW(GraphAlgorithms::GetShortestPathsDeltaStepping(graph, 12),
+               std::logic_error);
+}
+
+TEST(AllPairsShortestPaths, same_as_floyd_warshall) {
+  for (auto file : {"graph_directed3.txt", "graph_undirected.txt"}) {
+    Graph graph;
+    graph.LoadGraphFromFile(std::string("./resources/correct_graphs/") + file);
+    AllPairsShortestPaths apsp(graph);
+    apsp.RunAlgorithm();
+    EXPECT_TRUE(apsp.GetResult() ==
+                GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+    EXPECT_EQ(apsp.GetDistance(0, 0), 0);
+  }
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  AllPairsShortestPaths apsp(graph);
+  apsp.RunAlgorithm();
+  EXPECT_EQ(apsp.GetDistance(17, 13), 11);
+  EXPECT_EQ(apsp.GetDistance(1, 17), -1);
+  EXPECT_EQ(apsp.GetPredecessor(17, 16), 17);
+}
+
+TEST(AllPairsShortestPaths, update_edge) {
+  for (auto file : {"graph_directed3.txt", "graph_undirected.txt"}) {
+    Graph graph;
+    graph.LoadGraphFromFile(std::string("./resources/correct_graphs/") + file);
+    AllPairsShortestPaths apsp(graph);
+    apsp.RunAlgorithm();
+    int size = graph.GetGraph().size();
+    std::mt19937 gen(size);
+    std::uniform_int_distribution<int> vertex(0, size - 1);
+    std::uniform_int_distribution<int> weight(0, 30);
+    for (int step = 0; step < 200; ++step) {
+      int i = vertex(gen), j = vertex(gen), w = weight(gen);
+      graph.SetWeight(i, j, w);
+      apsp.UpdateEdge(i, j, w);
+      ASSERT_TRUE(apsp.GetResult() ==
+                  GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+    }
+  }
+}
+
+TEST(AllPairsShortestPaths, Exception) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  AllPairsShortestPaths apsp(graph);
+  EXPECT_THROW(apsp.UpdateEdge(0, 18, 1), std::out_of_range);
+  EXPECT_THROW(apsp.UpdateEdge(0, 1, -1), std::logic_error);
+  EXPECT_THROW(graph.SetWeight(-1, 0, 1), std::out_of_range);
+}
+
+int spanning_tree_weight(const GraphAlgorithms::Matrix& tree) {
+  int weight = 0;
+  for (size_t i = 0; i < tree.size(); i++) {
+    for (size_t j = 0; j < i; j++) weight += tree[i][j];
+  }
+  return weight;
+}
+
+TEST(MST, forest) {
+  Graph graph;
+  graph.LoadGraphFromFile(
+      "./resources/correct_graphs/graph_undirected_disconnected.txt");
+  GraphAlgorithms::Matrix forest =
+      GraphAlgorithms::GetLeastSpanningForest(graph).ToMatrix();
+  EXPECT_EQ(spanning_tree_weight(forest), 10);
+  EXPECT_EQ(forest[3][5], 1);
+  EXPECT_EQ(forest[3][4], 0);
+  EXPECT_THROW(GraphAlgorithms::GetLeastSpanningTree(graph), std::logic_error);
+  EXPECT_THROW(GraphAlgorithms::GetLeastSpanningTreeDense(graph),
+               std::logic_error);
+  EXPECT_THROW(GraphAlgorithms::GetLeastSpanningTreeKruskal(graph),
+               std::logic_error);
+  EXPECT_THROW(GraphAlgorithms::GetLeastSpanningTreeBoruvka(graph),
+               std::logic_error);
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  EXPECT_TRUE(GraphAlgorithms::GetLeastSpanningForest(graph).ToMatrix() ==
+              GraphAlgorithms::GetLeastSpanningTreeKruskal(graph).ToMatrix());
+}
+
+TEST(MST, all_algorithms) {
+  const std::vector<std::pair<std::string, int>> files = {
+      {"graph_undirected.txt", 150},
+      {"graph_undirected3.txt", 14},
+      {"graph_undirected_test1.txt", 6},
+      {"graph_undirected_test2.txt", 49}};
+  for (const auto &[file, weight] : files) {
+    Graph graph;
+    graph.LoadGraphFromFile("./resources/correct_graphs/" + file);
+    EXPECT_EQ(
+        spanning_tree_weight(GraphAlgorithms::GetLeastSpanningTree(graph)),
+        weight);
+    MstResult dense = GraphAlgorithms::GetLeastSpanningTreeDense(graph);
+    MstResult sparse = GraphAlgorithms::GetLeastSpanningTreeSparse(graph);
+    EXPECT_EQ(dense.weight, weight);
+    EXPECT_EQ(sparse.weight, weight);
+    EXPECT_EQ(spanning_tree_weight(dense.ToMatrix()), weight);
+    EXPECT_EQ(dense.edges.size() + 1, graph.GetGraph().size());
+    for (size_t threads : {1, 3}) {
+      MstResult kruskal =
+          GraphAlgorithms::GetLeastSpanningTreeKruskal(graph, threads);
+      MstResult boruvka =
+          GraphAlgorithms::GetLeastSpanningTreeBoruvka(graph, threads);
+      EXPECT_EQ(kruskal.weight, weight);
+      EXPECT_TRUE(kruskal.ToMatrix() == boruvka.ToMatrix());
+    }
+  }
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed.txt");
+  EXPECT_THROW(GraphAlgorithms::GetLeastSpanningTreeDense(graph),
+               std::logic_error);
+  EXPECT_THROW(GraphAlgorithms::GetLeastSpanningTreeSparse(graph),
+               std::logic_error);
+}
+
+TEST(MST, edges) {
+  Graph graph;
+  graph.LoadGraphFromFile(
+      "./resources/correct_graphs/graph_undirected_test2.txt");
+  MstResult result = GraphAlgorithms::GetLeastSpanningTreeEdges(graph);
+  EXPECT_EQ(result.edges.size(), 4U);
+  EXPECT_EQ(result.weight, 49);
+  EXPECT_EQ(result.size, 5U);
+  EXPECT_TRUE(result.ToMatrix() ==
+              GraphAlgorithms::GetLeastSpanningTree(graph));
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "../lib/local_search.h"
+
+TEST(LocalSearch, TwoOpt) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  LocalSearch search(graph);
+  LocalSearch::Tour tour = {0, 1, 2, 3};
+  EXPECT_EQ(search.GetLength(tour), 150);
+  EXPECT_TRUE(search.TwoOpt(&tour));
+  EXPECT_EQ(search.GetLength(tour), 120);
+  EXPECT_FALSE(search.TwoOpt(&tour));
+  EXPECT_EQ(search.GetLength(tour), 120);
+}
+
+TEST(LocalSearch, Directed) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed.txt");
+  LocalSearch search(graph);
+  LocalSearch::Tour tour(graph.GetGraph().size());
+  std::iota(tour.begin(), tour.end(), 0);
+  LocalSearch::Tour copy = tour;
+  EXPECT_FALSE(search.TwoOpt(&tour));
+  EXPECT_TRUE(tour == copy);
+}
+
+TEST(LocalSearch, OrOpt) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  LocalSearch search(graph);
+  LocalSearch::Tour tour(graph.GetGraph().size());
+  std::iota(tour.begin(), tour.end(), 0);
+  double length = search.GetLength(tour);
+  EXPECT_TRUE(search.OrOpt(&tour));
+  EXPECT_LT(search.GetLength(tour), length);
+  EXPECT_FALSE(search.OrOpt(&tour));
+  LocalSearch::Tour sorted = tour;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    EXPECT_EQ(sorted[i], static_cast<int>(i));
+  }
+}
+
+TEST(LocalSearch, Improve) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  LocalSearch search(graph, 4);
+  LocalSearch::Tour tour = {6, 0, 9, 1, 3, 8, 2, 10, 5, 4, 7};
+  LocalSearch::Tour copy = tour;
+  EXPECT_TRUE(search.Improve(&tour));
+  EXPECT_LT(search.GetLength(tour), search.GetLength(copy));
+  EXPECT_FALSE(search.TwoOpt(&tour));
+  EXPECT_FALSE(search.OrOpt(&tour));
+  EXPECT_FALSE(search.Improve(&tour));
+}
+
+TEST(LocalSearch, Polish) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  LocalSearch search(graph);
+  TsmResult closed = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0}, 0};
+  EXPECT_TRUE(search.Polish(&closed));
+  EXPECT_EQ(closed.vertices.size(), 12);
+  EXPECT_EQ(closed.vertices.front(), closed.vertices.back());
+  LocalSearch::Tour tour(closed.vertices.begin(), closed.vertices.end() - 1);
+  EXPECT_EQ(closed.distance, search.GetLength(tour));
+  TsmResult open = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, 0};
+  EXPECT_TRUE(search.Polish(&open));
+  EXPECT_EQ(open.vertices.size(), 11);
+  EXPECT_EQ(open.distance, search.GetLength(open.vertices));
+  TsmResult partial = {{0, 1, 2, 0}, 3};
+  EXPECT_FALSE(search.Polish(&partial));
+  EXPECT_EQ(partial.distance, 3);
+}
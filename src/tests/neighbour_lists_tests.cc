@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+
+#include "../lib/neighbour_lists.h"
+
+TEST(NeighbourLists, Nearest) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  NeighbourLists lists(graph, 2);
+  EXPECT_EQ(lists.GetCount(), 2U);
+  EXPECT_TRUE(lists[0] == NeighbourLists::List({1, 2}));
+  EXPECT_TRUE(lists[1] == NeighbourLists::List({0, 3}));
+  EXPECT_TRUE(lists[2] == NeighbourLists::List({0, 3}));
+  EXPECT_TRUE(lists[3] == NeighbourLists::List({0, 1}));
+}
+
+TEST(NeighbourLists, Short) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  NeighbourLists lists(graph, 10);
+  for (size_t i = 0; i < 4; ++i) EXPECT_EQ(lists[i].size(), 3U);
+  EXPECT_TRUE(lists[2] == NeighbourLists::List({0, 3, 1}));
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "../lib/random.h"
+
+TEST(Random, Reproducible) {
+  Random random1(42), random2(42), random3(43);
+  bool differs = false;
+  for (int i = 0; i < 100; ++i) {
+    uint64_t value = random1();
+    EXPECT_EQ(value, random2());
+    differs = differs || value != random3();
+  }
+  EXPECT_TRUE(differs);
+}
+
+TEST(Random, Ranges) {
+  Random random(7);
+  std::vector<int> counts(5);
+  for (int i = 0; i < 10000; ++i) {
+    int value = random.NextInt(-2, 2);
+    ASSERT_GE(value, -2);
+    ASSERT_LE(value, 2);
+    ++counts[value + 2];
+    double real = random.NextDouble(1.0, 3.0);
+    ASSERT_GE(real, 1.0);
+    ASSERT_LT(real, 3.0);
+  }
+  for (int count : counts) EXPECT_NEAR(count, 2000, 200);
+}
+
+TEST(Random, Shuffle) {
+  Random random(1);
+  std::vector<int> values(50);
+  std::iota(values.begin(), values.end(), 0);
+  std::vector<int> shuffled = values;
+  random.Shuffle(shuffled.begin(), shuffled.end());
+  EXPECT_FALSE(shuffled == values);
+  std::sort(shuffled.begin(), shuffled.end());
+  EXPECT_TRUE(shuffled == values);
+}
+
+TEST(Random, Derive) {
+  EXPECT_EQ(Random::Derive(5, 1), Random::Derive(5, 1));
+  EXPECT_NE(Random::Derive(5, 1), Random::Derive(5, 2));
+  EXPECT_NE(Random::Derive(5, 1), Random::Derive(6, 1));
+}
+
+TEST(Random, DeriveRun) {
+  EXPECT_EQ(Random::DeriveRun(5, 0), 5U);
+  EXPECT_EQ(Random::DeriveRun(5, 1), Random::DeriveRun(5, 1));
+  EXPECT_NE(Random::DeriveRun(5, 1), Random::DeriveRun(5, 2));
+  EXPECT_NE(Random::DeriveRun(5, 1), Random::Derive(5, 1));
+}
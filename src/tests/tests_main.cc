@@ -1,9 +1,17 @@
 #include <gtest/gtest.h>
 
+#include "cancellation_token_tests.cc"
+#include "disjoint_set_tests.cc"
+#include "distance_oracle_tests.cc"
 #include "graph_algorithms_tests.cc"
 #include "graph_tests.cc"
+#include "local_search_tests.cc"
+#include "neighbour_lists_tests.cc"
 #include "queue_tests.cc"
+#include "random_tests.cc"
 #include "stack_tests.cc"
+#include "thread_pool_tests.cc"
+#include "tour_construction_tests.cc"
 
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "../misc/thread_pool.h"
+
+TEST(ThreadPool, Submit) {
+  ThreadPool pool(4);
+  std::atomic<int> sum{0};
+  std::vector<std::future<void>> results;
+  for (int i = 1; i <= 100; ++i) {
+    results.push_back(pool.Submit([&sum, i] { sum += i; }));
+  }
+  for (auto& result : results) result.get();
+  EXPECT_EQ(sum, 5050);
+  EXPECT_EQ(pool.GetThreadsCount(), 4U);
+}
+
+TEST(ThreadPool, ParallelFor) {
+  ThreadPool pool(3);
+  std::vector<int> values(1000);
+  std::vector<int> threads(1000);
+  pool.ParallelFor(values.size(), [&](size_t i, size_t thread) {
+    values[i] = i * 2;
+    threads[i] = thread;
+  });
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], static_cast<int>(i * 2));
+    EXPECT_LT(threads[i], 3);
+  }
+}
+
+TEST(ThreadPool, Exception) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.ParallelFor(10,
+                                [](size_t i, size_t) {
+                                  if (i == 5) throw std::logic_error("");
+                                }),
+               std::logic_error);
+}
+
+TEST(ThreadPool, ParallelSort) {
+  ThreadPool pool(3);
+  std::vector<int> values(100000);
+  for (size_t i = 0; i < values.size(); ++i) values[i] = (i * 7919) % 100003;
+  std::vector<int> expected = values;
+  std::sort(expected.begin(), expected.end());
+  ParallelSort(pool, values.begin(), values.end(), std::less<int>());
+  EXPECT_TRUE(values == expected);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "../lib/tour_construction.h"
+
+TEST(TourConstruction, NearestNeighbour) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  TourConstruction construction(graph);
+  TourConstruction::Tour tour = construction.NearestNeighbour();
+  EXPECT_TRUE(tour == TourConstruction::Tour({0, 1, 3, 2}));
+  EXPECT_EQ(construction.GetLength(tour), 120);
+  EXPECT_EQ(construction.NearestNeighbour(2).front(), 2);
+  EXPECT_THROW(construction.NearestNeighbour(4), std::out_of_range);
+}
+
+TEST(TourConstruction, GreedyEdge) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected2.txt");
+  TourConstruction construction(graph);
+  TourConstruction::Tour tour = construction.GreedyEdge();
+  EXPECT_TRUE(TourConstruction::IsTour(tour, 4));
+  EXPECT_EQ(construction.GetLength(tour), 120);
+}
+
+TEST(TourConstruction, Christofides) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_undirected.txt");
+  TourConstruction construction(graph);
+  TourConstruction::Tour tour = construction.Christofides();
+  EXPECT_TRUE(TourConstruction::IsTour(tour, 11));
+  EXPECT_GE(construction.GetLength(tour), 253);
+  EXPECT_LT(construction.GetLength(tour), 2 * 253);
+}
+
+TEST(TourConstruction, Directed) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed.txt");
+  TourConstruction construction(graph);
+  const size_t size = graph.GetGraph().size();
+  EXPECT_TRUE(TourConstruction::IsTour(construction.NearestNeighbour(), size));
+  EXPECT_TRUE(TourConstruction::IsTour(construction.GreedyEdge(), size));
+  EXPECT_TRUE(construction.Christofides() == construction.GreedyEdge());
+}
+
+TEST(TourConstruction, MissingEdges) {
+  Graph graph;
+  graph.LoadGraphFromFile("./resources/correct_graphs/graph_directed3.txt");
+  TourConstruction construction(graph);
+  const size_t size = graph.GetGraph().size();
+  TourConstruction::Tour tour = construction.GreedyEdge();
+  EXPECT_TRUE(TourConstruction::IsTour(tour, size));
+  EXPECT_TRUE(TourConstruction::IsTour(construction.NearestNeighbour(), size));
+  EXPECT_EQ(construction.GetLength(tour),
+            std::numeric_limits<double>::infinity());
+}
+
+TEST(TourConstruction, SpaceFillingCurve) {
+  std::vector<TourConstruction::Point> points = {
+      {0.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {1.0, 0.0}};
+  EXPECT_TRUE(TourConstruction::SpaceFillingCurve(points) ==
+              TourConstruction::Tour({0, 2, 1, 3}));
+  EXPECT_TRUE(TourConstruction::SpaceFillingCurve({}).empty());
+  EXPECT_TRUE(TourConstruction::SpaceFillingCurve({{5.0, 5.0}}) ==
+              TourConstruction::Tour({0}));
+}
+
+TEST(TourConstruction, IsTour) {
+  EXPECT_TRUE(TourConstruction::IsTour({2, 0, 1}, 3));
+  EXPECT_FALSE(TourConstruction::IsTour({0, 1}, 3));
+  EXPECT_FALSE(TourConstruction::IsTour({0, 1, 1}, 3));
+  EXPECT_FALSE(TourConstruction::IsTour({0, 1, 3}, 3));
+  EXPECT_FALSE(TourConstruction::IsTour({0, -1, 2}, 3));
+}
@@ -39,6 +39,15 @@ void Console::PrintVector(GraphAlgorithms::Vector const &v) {
   std::cout << "\u001b[0m\n\n";
 }
 
+void Console::PrintSpanningTree(MstResult const &tree) {
+  for (const auto &edge : tree.edges) {
+    std::cout << "\u001b[43;1m" << std::setw(4) << edge.from + 1 << " -- "
+              << std::setw(4) << edge.to + 1 << ": " << std::setw(4)
+              << edge.weight << "\u001b[0m\n";
+  }
+  std::cout << "\n\u001b[43;1mWEIGHT: " << tree.weight << "\u001b[0m\n\n";
+}
+
 int Console::InputNumber(const std::string &str) {
   int res;
   while (1) {
@@ -110,7 +119,7 @@ bool Console::ChooseMenuItem() {
     case 6:
       system("clear");
       try {
-        PrintMatrix(controller_->SixthItem());
+        PrintSpanningTree(controller_->SixthItem());
       } catch (std::logic_error &e) {
         std::cout << "\u001b[41;1m" << e.what() << "\u001b[0m\n";
       }
@@ -146,6 +155,9 @@ bool Console::ChooseMenuItem() {
         std::cout << "\u001b[33;1mGENETIC ALGORITHM: \u001b[0m\nDistance: "
                   << (int)res[2].first << " Time: " << res[2].second
                   << std::endl;
+        std::cout << "\u001b[33;1mLIN-KERNIGHAN ALGORITHM: \u001b[0m\n"
+                  << "Distance: " << (int)res[3].first
+                  << " Time: " << res[3].second << std::endl;
       } catch (std::out_of_range &e) {
         std::cout << "\u001b[41;1m" << e.what() << "\u001b[0m\n\n";
       } catch (std::logic_error &e) {
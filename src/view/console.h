@@ -18,6 +18,7 @@ class Console {
 
   void PrintMatrix(GraphAlgorithms::Matrix const& m);
   void PrintVector(GraphAlgorithms::Vector const& v);
+  void PrintSpanningTree(MstResult const& tree);
   bool ChooseMenuItem();
   void PrintChosenFile();
   void InputFilename();